@@ -5625,7 +5625,8 @@ Editor::reset_point_selection ()
 {
 	for (PointSelection::iterator i = selection->points.begin(); i != selection->points.end(); ++i) {
 		ARDOUR::AutomationList::iterator j = (*i)->model ();
-		(*j)->value = (*i)->line().the_list()->descriptor ().normal;
+		std::shared_ptr<ARDOUR::AutomationList> al = (*i)->line().the_list();
+		al->modify (j, (*j)->when, al->descriptor ().normal);
 	}
 }
 
@@ -4794,6 +4794,23 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		ComboOption<ProcessGraphScheduler>* gs = new ComboOption<ProcessGraphScheduler> (
+				"process-graph-scheduler",
+				_("Parallel route processing"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_process_graph_scheduler),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_process_graph_scheduler)
+				);
+
+		gs->add (SharedQueueScheduler, _("shared queue"));
+		gs->add (WorkStealingScheduler, _("per-thread queues with work-stealing"));
+
+		Gtkmm2ext::UI::instance()->set_tip (gs->tip_widget(),
+				_("Scheduler used to distribute routes to DSP threads. "
+				  "Work-stealing keeps routes that feed each other on the same thread, "
+				  "which reduces inter-thread synchronization in large sessions."));
+
+		add_option (_("Performance"), gs);
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
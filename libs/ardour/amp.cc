@@ -176,13 +176,7 @@ Amp::apply_gain (BufferSet& bufs, samplecnt_t sample_rate, samplecnt_t nframes,
 	const gain_t a = 156.825f / (gain_t)sample_rate; // 25 Hz LPF
 
 	for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-		Sample* const buffer = i->data();
-		double lpf = initial;
-
-		for (pframes_t nx = 0; nx < nframes; ++nx) {
-			buffer[nx] *= lpf;
-			lpf += a * (target - lpf);
-		}
+		const gain_t lpf = apply_gain_ramp (i->data(), nframes, initial, target, a);
 		if (i == bufs.audio_begin()) {
 			rv = lpf;
 		}
@@ -258,11 +252,7 @@ Amp::apply_gain (AudioBuffer& buf, samplecnt_t sample_rate, samplecnt_t nframes,
 	Sample* const buffer = buf.data (offset);
 	const gain_t a = 156.825f / (gain_t)sample_rate; // 25 Hz LPF, see [other] Amp::apply_gain() above for details
 
-	gain_t lpf = initial;
-	for (pframes_t nx = 0; nx < nframes; ++nx) {
-		buffer[nx] *= lpf;
-		lpf += a * (target - lpf);
-	}
+	const gain_t lpf = apply_gain_ramp (buffer, nframes, initial, target, a);
 
 	if (fabsf (lpf - target) < GAIN_COEFF_DELTA) return target;
 	return lpf;
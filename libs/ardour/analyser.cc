@@ -21,11 +21,13 @@
 
 #include "ardour/analyser.h"
 #include "ardour/audiofilesource.h"
+#include "ardour/debug.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/session_event.h"
 #include "ardour/transient_detector.h"
 
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 
 #include "pbd/i18n.h"
@@ -34,12 +36,18 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
-Glib::Threads::Mutex          Analyser::analysis_active_lock;
 Glib::Threads::Mutex          Analyser::analysis_queue_lock;
+Glib::Threads::Mutex          Analyser::analysis_plugin_lock;
 Glib::Threads::Cond           Analyser::SourcesToAnalyse;
+Glib::Threads::Cond           Analyser::AnalysisDone;
 list<std::weak_ptr<Source>> Analyser::analysis_queue;
+Analyser::ActiveJobs          Analyser::active_jobs;
 bool                          Analyser::analysis_thread_run = false;
-PBD::Thread*                  Analyser::analysis_thread     = 0;
+vector<PBD::Thread*>          Analyser::analysis_threads;
+uint64_t                      Analyser::flush_count         = 0;
+size_t                        Analyser::n_analysed          = 0;
+int64_t                       Analyser::analysis_time_total = 0;
+int64_t                       Analyser::analysis_time_max   = 0;
 
 Analyser::Analyser ()
 {
@@ -52,7 +60,13 @@ Analyser::init ()
 		return;
 	}
 	analysis_thread_run = true;
-	analysis_thread     = PBD::Thread::create (sigc::ptr_fun (&Analyser::work), "Analyzer");
+
+	/* analysis is disk and CPU bound, a few threads are sufficient */
+	uint32_t const n_threads = std::max<uint32_t> (1, std::min<uint32_t> (4, hardware_concurrency () - 1));
+
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		analysis_threads.push_back (PBD::Thread::create (sigc::ptr_fun (&Analyser::work), string_compose ("Analyzer %1", i)));
+	}
 }
 
 void
@@ -61,9 +75,21 @@ Analyser::terminate ()
 	if (!analysis_thread_run) {
 		return;
 	}
-	analysis_thread_run = false;
-	SourcesToAnalyse.broadcast ();
-	analysis_thread->join ();
+
+	{
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		analysis_thread_run = false;
+		for (ActiveJobs::iterator i = active_jobs.begin (); i != active_jobs.end (); ++i) {
+			cancel_job (i->second);
+		}
+		SourcesToAnalyse.broadcast ();
+		AnalysisDone.broadcast ();
+	}
+
+	for (vector<PBD::Thread*>::iterator i = analysis_threads.begin (); i != analysis_threads.end (); ++i) {
+		(*i)->join ();
+	}
+	analysis_threads.clear ();
 }
 
 void
@@ -78,8 +104,35 @@ Analyser::queue_source_for_analysis (std::shared_ptr<Source> src, bool force)
 	}
 
 	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	for (list<std::weak_ptr<Source> >::const_iterator i = analysis_queue.begin (); i != analysis_queue.end (); ++i) {
+		if (i->lock () == src) {
+			/* already queued */
+			return;
+		}
+	}
+
+	ActiveJobs::iterator j = active_jobs.find (src.get ());
+	if (j != active_jobs.end ()) {
+		if (!force) {
+			return;
+		}
+		/* the source changed, restart the analysis */
+		cancel_job (j->second);
+	}
+
 	analysis_queue.push_back (std::weak_ptr<Source> (src));
-	SourcesToAnalyse.broadcast ();
+	SourcesToAnalyse.signal ();
+}
+
+void
+Analyser::cancel_job (Job& job)
+{
+	/* analysis_queue_lock must be held */
+	job.cancelled = true;
+	if (job.detector) {
+		job.detector->cancel ();
+	}
 }
 
 void
@@ -106,42 +159,139 @@ Analyser::work ()
 
 		std::shared_ptr<Source> src (analysis_queue.front ().lock ());
 		analysis_queue.pop_front ();
-		analysis_queue_lock.unlock ();
 
 		std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (src);
 
-		if (afs && !afs->empty ()) {
-			Glib::Threads::Mutex::Lock lm (analysis_active_lock);
-			analyse_audio_file_source (afs);
+		if (!afs || afs->empty ()) {
+			/* the source was dropped since it was queued */
+			analysis_queue_lock.unlock ();
+			continue;
 		}
+
+		/* wait for a cancelled analysis of the same source to end */
+		uint64_t const flushed = flush_count;
+		while (active_jobs.find (afs.get ()) != active_jobs.end () && analysis_thread_run) {
+			AnalysisDone.wait (analysis_queue_lock);
+		}
+
+		if (!analysis_thread_run) {
+			analysis_queue_lock.unlock ();
+			break;
+		}
+
+		if (flushed != flush_count) {
+			analysis_queue_lock.unlock ();
+			continue;
+		}
+
+		active_jobs[afs.get ()] = Job ();
+
+		DEBUG_TRACE (DEBUG::Analysis, string_compose ("Analysing %1, %2 sources left in queue\n", afs->name (), analysis_queue.size ()));
+
+		analysis_queue_lock.unlock ();
+
+		int64_t const start = g_get_monotonic_time ();
+		int const rv = analyse_audio_file_source (afs);
+		int64_t const elapsed = g_get_monotonic_time () - start;
+
+		DEBUG_TRACE (DEBUG::Analysis, string_compose ("Analysis of %1 %2 after %3 ms\n", afs->name (), rv == 0 ? "completed" : "stopped", elapsed / 1000.0));
+
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		active_jobs.erase (afs.get ());
+		if (rv == 0) {
+			++n_analysed;
+			analysis_time_total += elapsed;
+			analysis_time_max = std::max (analysis_time_max, elapsed);
+		}
+		AnalysisDone.broadcast ();
 	}
 }
 
-void
+int
 Analyser::analyse_audio_file_source (std::shared_ptr<AudioFileSource> src)
 {
 	AnalysisFeatureList results;
+	TransientDetector*  td = 0;
+	int                 rv = -1;
 
 	try {
-		TransientDetector td (src->sample_rate ());
-		td.set_sensitivity (3, Config->get_transient_sensitivity ()); // "General purpose"
-		if (td.run (src->get_transients_path (), src.get (), 0, results) == 0) {
-			src->set_been_analysed (true);
-		} else {
-			src->set_been_analysed (false);
+		{
+			/* VAMP plugins are not loaded concurrently */
+			Glib::Threads::Mutex::Lock lp (analysis_plugin_lock);
+			td = new TransientDetector (src->sample_rate ());
+		}
+
+		td->set_sensitivity (3, Config->get_transient_sensitivity ()); // "General purpose"
+
+		{
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+			Job& job (active_jobs[src.get ()]);
+			if (job.cancelled) {
+				td->cancel ();
+			}
+			job.detector = td;
+		}
+
+		rv = td->run (src->get_transients_path (), src.get (), 0, results);
+
+		bool cancelled;
+		{
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+			Job& job (active_jobs[src.get ()]);
+			cancelled    = job.cancelled;
+			job.detector = 0;
+		}
+
+		/* a cancelled analysis is either restarted, or no longer needed */
+		if (!cancelled) {
+			src->set_been_analysed (rv == 0);
+		}
+		if (cancelled) {
+			rv = -1;
 		}
 	} catch (...) {
 		error << string_compose (_ ("Transient Analysis failed for %1."), _ ("Audio File Source")) << endmsg;
-		;
+		{
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+			active_jobs[src.get ()].detector = 0;
+		}
 		src->set_been_analysed (false);
-		return;
+		rv = -1;
 	}
+
+	Glib::Threads::Mutex::Lock lp (analysis_plugin_lock);
+	delete td;
+
+	return rv;
 }
 
 void
 Analyser::flush ()
 {
-	Glib::Threads::Mutex::Lock lq (analysis_queue_lock);
-	Glib::Threads::Mutex::Lock la (analysis_active_lock);
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
 	analysis_queue.clear ();
+	++flush_count;
+
+	for (ActiveJobs::iterator i = active_jobs.begin (); i != active_jobs.end (); ++i) {
+		cancel_job (i->second);
+	}
+	while (!active_jobs.empty ()) {
+		AnalysisDone.wait (analysis_queue_lock);
+	}
+}
+
+size_t
+Analyser::queue_depth ()
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+	return analysis_queue.size () + active_jobs.size ();
+}
+
+void
+Analyser::get_stats (size_t& n, int64_t& total_usec, int64_t& max_usec)
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+	n          = n_analysed;
+	total_usec = analysis_time_total;
+	max_usec   = analysis_time_max;
 }
@@ -20,7 +20,10 @@
 #ifndef __ardour_analyser_h__
 #define __ardour_analyser_h__
 
+#include <list>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "pbd/pthread_utils.h"
@@ -29,7 +32,11 @@ namespace ARDOUR
 {
 class AudioFileSource;
 class Source;
+class TransientDetector;
 
+/** Transient analysis of audio sources, using a pool of worker threads
+ * that each analyse one source at a time.
+ */
 class LIBARDOUR_API Analyser
 {
 public:
@@ -39,17 +46,39 @@ public:
 	static void terminate ();
 	static void queue_source_for_analysis (std::shared_ptr<Source>, bool force);
 	static void work ();
+	/** Drop all queued sources, cancel and wait for running analyses */
 	static void flush ();
 
+	/** @return number of sources that are queued or being analysed */
+	static size_t queue_depth ();
+	/** Number of sources analysed so far, and the time this took in microseconds */
+	static void get_stats (size_t& n_analysed, int64_t& total_usec, int64_t& max_usec);
+
 private:
-	static Glib::Threads::Mutex               analysis_active_lock;
+	struct Job {
+		Job () : detector (0), cancelled (false) {}
+		TransientDetector* detector;
+		bool               cancelled;
+	};
+
+	typedef std::map<Source const*, Job> ActiveJobs;
+
 	static Glib::Threads::Mutex               analysis_queue_lock;
+	static Glib::Threads::Mutex               analysis_plugin_lock;
 	static Glib::Threads::Cond                SourcesToAnalyse;
+	static Glib::Threads::Cond                AnalysisDone;
 	static std::list<std::weak_ptr<Source>> analysis_queue;
+	static ActiveJobs                         active_jobs;
 	static bool                               analysis_thread_run;
-	static PBD::Thread*                       analysis_thread;
+	static std::vector<PBD::Thread*>          analysis_threads;
+	static uint64_t                           flush_count;
+
+	static size_t  n_analysed;
+	static int64_t analysis_time_total;
+	static int64_t analysis_time_max;
 
-	static void analyse_audio_file_source (std::shared_ptr<AudioFileSource>);
+	static void cancel_job (Job&);
+	static int  analyse_audio_file_source (std::shared_ptr<AudioFileSource>);
 };
 
 } // namespace ARDOUR
@@ -21,6 +21,7 @@
 #ifndef __ardour_audioanalyser_h__
 #define __ardour_audioanalyser_h__
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <boost/utility.hpp>
@@ -51,6 +52,9 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 
 	void reset ();
 
+	/** Abort a running analysis, may be called from any thread */
+	void cancel () { _cancel.store (1); }
+
   protected:
 	float sample_rate;
 	AnalysisPlugin* plugin;
@@ -68,6 +72,9 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 	*/
 
 	virtual int use_features (Vamp::Plugin::FeatureSet&, std::ostream*) = 0;
+
+  private:
+	std::atomic<int> _cancel;
 };
 
 } /* namespace */
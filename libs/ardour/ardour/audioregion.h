@@ -23,6 +23,7 @@
 #ifndef __ardour_audio_region_h__
 #define __ardour_audio_region_h__
 
+#include <atomic>
 #include <vector>
 #include <list>
 
@@ -246,6 +247,39 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 	uint32_t               _fade_in_suspended;
 	uint32_t               _fade_out_suspended;
 
+	/* Fades and envelope rendered with one value per sample, to be used
+	 * by read_at() instead of evaluating the curve for every read.
+	 */
+	enum GainCurve {
+		FadeInCurve = 0,
+		InverseFadeInCurve,
+		FadeOutCurve,
+		InverseFadeOutCurve,
+		EnvelopeCurve,
+		NumGainCurves
+	};
+
+	struct RenderedGainCurve {
+		RenderedGainCurve (samplecnt_t n) : gain (new gain_t[n]), length (n) {}
+		~RenderedGainCurve () { delete [] gain; }
+
+		gain_t*               gain;
+		samplecnt_t           length;
+		uint32_t              generation;
+		AutomationList const* list;
+		int                   sample_rate;
+
+	private:
+		RenderedGainCurve (RenderedGainCurve const&);
+	};
+
+	std::shared_ptr<const RenderedGainCurve> rendered_gain_curve (GainCurve, AutomationList const&, samplecnt_t) const;
+	gain_t const* gain_curve (GainCurve, AutomationList const&, samplecnt_t, sampleoffset_t, samplecnt_t, gain_t*, std::shared_ptr<const RenderedGainCurve>&) const;
+	void invalidate_gain_curve (GainCurve);
+
+	mutable std::shared_ptr<RenderedGainCurve> _gain_curve[NumGainCurves];
+	std::atomic<uint32_t>                      _gain_curve_generation[NumGainCurves];
+
 	std::shared_ptr<ARDOUR::Region> get_single_other_xfade_region (bool start) const;
 
   protected:
@@ -97,6 +97,11 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int prepare_for_peakfile_writes ();
 	void done_with_peakfile_writes (bool done = true);
 
+	/** @return true if the coarser peak levels need to be derived from the peakfile */
+	bool peak_levels_missing () const;
+	/** (re)create the coarser peak levels from the peakfile, not realtime safe */
+	int  build_peak_levels ();
+
 	/** @return true if the each source sample s must be clamped to -1 < s < 1 */
 	virtual bool clamped_at_unity () const = 0;
 
@@ -136,6 +141,15 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 				     bool force, bool intermediate_peaks_ready_signal,
 				     samplecnt_t samples_per_peak);
 
+	/* Coarser peak levels are kept in sidecar files next to _peakpath.
+	 * Each level reduces the one below by a fixed ratio, level 0
+	 * being the plain peakfile.
+	 */
+	static const uint32_t n_peak_levels = 2;
+
+	std::string peak_level_path (uint32_t level) const;
+	void remove_peak_levels ();
+
   private:
 	bool _peaks_built;
 	/** This mutex is used to protect both the _peaks_built
@@ -148,6 +162,11 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
         Glib::Threads::Mutex _initialize_peaks_lock;
 
 	int        _peakfile_fd;
+	int        _peak_level_fd[n_peak_levels];
+	off_t      _peak_level_byte_max[n_peak_levels];
+	PeakData   _peak_level_acc[n_peak_levels];     // the peak of each level being filled
+	samplepos_t _peak_level_acc_pos[n_peak_levels]; // its index, -1 if none
+
 	samplecnt_t peak_leftover_cnt;
 	samplecnt_t peak_leftover_size;
 	Sample*    peak_leftovers;
@@ -157,7 +176,14 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	mutable double _last_scale;
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
+	mutable samplecnt_t _last_fpp;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	bool peak_level_valid (uint32_t level, samplepos_t end) const;
+	int  open_peak_levels ();
+	void close_peak_levels ();
+	int  update_peak_levels (uint32_t level, PeakData const* peaks, samplepos_t first_peak, samplecnt_t n_peaks);
+	int  write_peak_level (uint32_t level, PeakData const* peaks, samplepos_t first_peak, samplecnt_t n_peaks);
 };
 
 }
@@ -24,6 +24,7 @@
 #define __ardour_butler_h__
 
 #include <atomic>
+#include <vector>
 
 #include <pthread.h>
 
@@ -33,6 +34,7 @@
 #include "pbd/pool.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/mpmc_queue.h"
+#include "pbd/semutils.h"
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/session_handle.h"
@@ -40,6 +42,8 @@
 
 namespace ARDOUR
 {
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -94,19 +98,54 @@ private:
 	};
 
 
+	/** A refill or write-behind of a single track */
+	struct DiskJob {
+		DiskJob (std::shared_ptr<Track> t, float l)
+			: track (t)
+			, buffer_load (l)
+			, retval (0)
+		{}
+
+		std::shared_ptr<Track> track;
+		float                  buffer_load;
+		int                    retval;
+	};
+
+	enum DiskJobType {
+		Refill,
+		Flush
+	};
+
 	static void* _thread_work (void* arg);
+	static void* _helper_thread_work (void* arg);
 
 	void* thread_work ();
+	void* helper_thread_work ();
 
 	void empty_pool_trash ();
 	void process_delegated_work ();
 	void config_changed (std::string);
+	bool refill_tracks (RouteList const&);
 	bool flush_tracks_to_disk_normal (std::shared_ptr<RouteList const>, uint32_t& errors);
 	void queue_request (Request::Type r);
 
+	void start_helpers (uint32_t n_helpers);
+	void stop_helpers ();
+	void run_disk_jobs (DiskJobType);
+	void process_disk_jobs ();
+
 	pthread_t thread;
 	bool      have_thread;
 
+	/* additional threads to process tracks in parallel */
+	std::vector<pthread_t> _helpers;
+	std::vector<DiskJob>   _disk_jobs;
+	DiskJobType            _disk_job_type;
+	std::atomic<size_t>    _disk_job_index;
+	std::atomic<int>       _helpers_quit;
+	PBD::Semaphore         _helpers_start;
+	PBD::Semaphore         _helpers_done;
+
 	Glib::Threads::Mutex request_lock;
 	Glib::Threads::Cond  paused;
 	bool                 should_run;
@@ -33,6 +33,19 @@ namespace ARDOUR { namespace DSP {
 class LIBARDOUR_API Convolution : public SessionHandleRef
 {
 public:
+	/** Partitioning of the impulse response.
+	 *
+	 * The first (head) partition is processed in the calling thread and
+	 * its size is the latency of the buffered run methods. Larger tail
+	 * partitions are processed by background threads.
+	 */
+	enum LatencyMode {
+		Unthreaded, ///< uniform partitions of the session's block-size, no background threads
+		LowLatency, ///< 64 samples head partition
+		Balanced,   ///< 256 samples head partition
+		LowCPU,     ///< 1024 samples head partition
+	};
+
 	Convolution (Session&, uint32_t n_in, uint32_t n_out);
 	virtual ~Convolution () {}
 
@@ -51,6 +64,19 @@ public:
 	uint32_t n_inputs () const  { return _n_inputs; }
 	uint32_t n_outputs () const { return _n_outputs; }
 
+	LatencyMode latency_mode () const { return _latency_mode; }
+	void        set_latency_mode (LatencyMode);
+
+	/** @return fraction of realtime spent processing the head partition in
+	 * the calling thread, averaged since the last restart
+	 */
+	float dsp_load () const;
+
+	/** @return number of cycles since the last restart, in which background
+	 * threads did not complete the tail partitions in time
+	 */
+	uint32_t late_cycles () const { return _late_cycles; }
+
 	void clear_impdata ();
 	void restart ();
 	void run (BufferSet&, ChanMapping const&, ChanMapping const&, pframes_t, samplecnt_t);
@@ -59,13 +85,19 @@ public:
 	void run_mono_no_latency (float*, uint32_t);
 
 protected:
+	void process ();
+
 	ArdourZita::Convproc _convproc;
 
-	uint32_t _n_samples;
-	uint32_t _max_size;
-	uint32_t _offset;
-	bool     _configured;
-	bool     _threaded;
+	uint32_t    _n_samples;
+	uint32_t    _max_size;
+	uint32_t    _offset;
+	bool        _configured;
+	LatencyMode _latency_mode;
+	uint64_t    _proc_usec;
+	uint64_t    _proc_samples;
+	uint32_t    _late_cycles;
+	samplecnt_t _sample_rate;
 
 private:
 	class ImpData : public AudioReadable
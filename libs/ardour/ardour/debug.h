@@ -32,6 +32,7 @@
 
 namespace PBD {
 	namespace DEBUG {
+		LIBARDOUR_API extern DebugBits Analysis;
 		LIBARDOUR_API extern DebugBits AudioEngine;
 		LIBARDOUR_API extern DebugBits AudioPlayback;
 		LIBARDOUR_API extern DebugBits AudioUnitConfig;
@@ -90,6 +90,11 @@ public:
 	static void allocate_working_buffers ();
 	static void free_working_buffers ();
 
+	/* Working buffers for do_refill, used by the calling thread
+	 * instead of the shared ones (additional butler threads) */
+	static void allocate_thread_working_buffers ();
+	static void free_thread_working_buffers ();
+
 	void adjust_buffering ();
 
 	bool can_internal_playback_seek (sampleoffset_t distance);
@@ -175,7 +180,6 @@ protected:
 
 	private:
 		float _a;
-		float _l;
 		float _g;
 	};
 
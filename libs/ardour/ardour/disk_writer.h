@@ -99,6 +99,7 @@ public:
 	samplepos_t get_capture_start_sample (uint32_t n = 0) const;
 	samplecnt_t get_captured_samples (uint32_t n = 0) const;
 
+	/** @return fraction of free capture buffer space of the fullest channel */
 	float buffer_load () const;
 
 	int seek (samplepos_t sample, bool complete_refill);
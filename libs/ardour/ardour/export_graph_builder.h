@@ -46,7 +46,7 @@ namespace AudioGrapher {
 	template <typename T> class CmdPipeWriter;
 	template <typename T> class SilenceTrimmer;
 	template <typename T> class TmpFile;
-	template <typename T> class Threader;
+	class ThreaderException;
 	template <typename T> class AllocatingProcessContext;
 }
 
@@ -94,6 +94,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
+	bool parallel() const { return _parallel; }
 	unsigned get_postprocessing_cycle_count() const;
 
 	void reset ();
@@ -101,6 +102,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	void set_current_timespan (std::shared_ptr<ExportTimespan> span);
 	void add_config (FileSpec const & config, bool rt);
 	void get_analysis_results (AnalysisResults& results);
+	void get_postprocessing_progress (std::map<std::string, float>& progress) const;
 
 	std::vector<std::string> exported_files () const {
 		return _exported_files;
@@ -169,6 +171,8 @@ class LIBARDOUR_API ExportGraphBuilder
 		void set_peak_dbfs (float, bool force = false);
 		void set_peak_lufs (AudioGrapher::LoudnessReader const&);
 
+		std::string name () const;
+
 	private:
 		typedef std::shared_ptr<AudioGrapher::Chunker<float> > ChunkerPtr;
 		typedef std::shared_ptr<AudioGrapher::DemoNoiseAdder> DemoNoisePtr;
@@ -203,15 +207,18 @@ class LIBARDOUR_API ExportGraphBuilder
 		bool operator== (FileSpec const & other_config) const;
 
 		unsigned get_postprocessing_cycle_count() const;
+		void get_progress (std::map<std::string, float>& progress) const;
 
-		/// Returns true when finished
+		/** Read the next chunk from the temp file, and queue
+		 * processing it for each child.
+		 * @return true when finished
+		 */
 		bool process ();
 
 	private:
 		typedef std::shared_ptr<AudioGrapher::PeakReader> PeakReaderPtr;
 		typedef std::shared_ptr<AudioGrapher::LoudnessReader> LoudnessReaderPtr;
 		typedef std::shared_ptr<AudioGrapher::TmpFile<Sample> > TmpFilePtr;
-		typedef std::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
 		typedef std::shared_ptr<AudioGrapher::AllocatingProcessContext<Sample> > BufferPtr;
 
 		void prepare_post_processing ();
@@ -226,7 +233,7 @@ class LIBARDOUR_API ExportGraphBuilder
 		BufferPtr       buffer;
 		PeakReaderPtr   peak_reader;
 		TmpFilePtr      tmp_file;
-		ThreaderPtr     threader;
+		samplecnt_t     samples_read;
 
 		LoudnessReaderPtr    loudness_reader;
 		boost::ptr_list<SFC> children;
@@ -310,10 +317,34 @@ class LIBARDOUR_API ExportGraphBuilder
 	samplecnt_t process_buffer_samples;
 
 	std::list<Intermediate *> intermediates;
+	std::list<Intermediate *> postprocessed; // including finished ones, for progress reports
 
 	AnalysisMap analysis_map;
 
+	/* Post-processing: every SFC of every Intermediate is an independent
+	 * branch. All branches are processed concurrently, and the next chunk
+	 * is read only once all of them completed the current one.
+	 */
+	struct Branch {
+		Branch (FloatSinkPtr s, AudioGrapher::ProcessContext<Sample> const& c) : sink (s), context (c) {}
+		FloatSinkPtr                         sink;
+		AudioGrapher::ProcessContext<Sample> context;
+	};
+
+	void queue_branch (FloatSinkPtr, AudioGrapher::ProcessContext<Sample> const&);
+	void run_branches ();
+	void run_branch (size_t);
+	void process_branch (size_t);
+
+	std::vector<Branch>  branches;
+	size_t               branches_pending;
+	Glib::Threads::Mutex branch_lock;
+	Glib::Threads::Cond  branch_cond;
+
+	std::shared_ptr<AudioGrapher::ThreaderException> branch_exception;
+
 	bool        _realtime;
+	bool        _parallel;
 	samplecnt_t _master_align;
 
 	Glib::ThreadPool     thread_pool;
@@ -23,6 +23,8 @@
 #ifndef __ardour_export_status_h__
 #define __ardour_export_status_h__
 
+#include <map>
+#include <string>
 #include <stdint.h>
 
 #include "ardour/libardour_visibility.h"
@@ -83,6 +85,10 @@ class LIBARDOUR_API ExportStatus {
 	volatile uint32_t       total_postprocessing_cycles;
 	volatile uint32_t       current_postprocessing_cycle;
 
+	/** Post-processing progress [0..1] of each output file */
+	std::map<std::string, float> postprocessing_progress () const;
+	void set_postprocessing_progress (std::map<std::string, float> const&);
+
 	AnalysisResults         result_map;
 
   private:
@@ -91,6 +97,9 @@ class LIBARDOUR_API ExportStatus {
 	volatile bool          _running;
 
 	Glib::Threads::Mutex   _run_lock;
+
+	mutable Glib::Threads::Mutex _progress_lock;
+	std::map<std::string, float> _postprocessing_progress;
 };
 
 } // namespace ARDOUR
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -32,6 +33,7 @@
 
 
 #include "pbd/mpmc_queue.h"
+#include "pbd/rcu.h"
 #include "pbd/semutils.h"
 
 #include "ardour/audio_backend.h"
@@ -45,6 +47,7 @@ class ProcessNode;
 class GraphNode;
 class Graph;
 
+class GraphWorker;
 class IOPlug;
 class Route;
 class RTTaskList;
@@ -62,11 +65,65 @@ struct GraphChain {
 	void dump () const;
 	bool plot (std::string const&) const;
 
+	/** Length of the longest path through the graph, weighted by
+	 * the measured DSP cost of each node [usec]
+	 */
+	double critical_path () const { return _critical_path.load (); }
+
+	/** Sum of the DSP cost of all nodes [usec] */
+	double total_cost () const { return _total_cost.load (); }
+
+	/** Upper bound of the speedup that can be achieved by processing
+	 * nodes in parallel, regardless of the number of threads.
+	 */
+	double max_parallel_speedup () const {
+		double const cp = critical_path ();
+		return cp > 0 ? total_cost () / cp : 1.0;
+	}
+
+	/** Re-order the initial trigger list and the activation order of
+	 * all nodes by the longest remaining cost-weighted path, using the
+	 * DSP cost measured since the chain was built.
+	 *
+	 * When the chain is built (e.g. at session load) most nodes have
+	 * not been processed yet, so this is called periodically from a
+	 * non-realtime thread while the chain is in use.
+	 */
+	void rank ();
+
+	/** Nodes that are not fed by any other nodes, longest critical-path first */
+	std::shared_ptr<node_list_t const> init_trigger_list () const { return _init_trigger_list.reader (); }
+
 	node_list_t _nodes_rt;
-	/** Nodes that are not fed by any other nodes */
-	node_list_t _init_trigger_list;
 	/** The number of nodes that do not feed any other node */
 	int _n_terminal_nodes;
+
+private:
+	typedef std::map<GraphNode const*, double> CostMap;
+
+	double node_cost (GraphNode const*) const;
+	double remaining_path (node_ptr_t const&, CostMap&) const;
+
+	SerializedRCUManager<node_list_t> _init_trigger_list;
+
+	std::atomic<double> _critical_path;
+	std::atomic<double> _total_cost;
+};
+
+/** Per-cycle statistics of the work-stealing scheduler */
+struct LIBARDOUR_API GraphSchedulerStats {
+	GraphSchedulerStats ()
+		: n_steals (0)
+		, n_sleeps (0)
+		, idle_usec (0)
+	{}
+
+	/** Nodes that were executed by a thread other than the one that triggered them */
+	uint32_t n_steals;
+	/** Number of times a worker ran out of work and went to sleep */
+	uint32_t n_sleeps;
+	/** Accumulated time that workers spent waiting for work */
+	uint32_t idle_usec;
 };
 
 class LIBARDOUR_API Graph : public SessionHandleRef
@@ -77,12 +134,15 @@ public:
 	/* public API for use by session-process */
 	int process_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes, samplepos_t start_sample, samplepos_t end_sample, bool& need_butler);
 	int routes_no_roll (std::shared_ptr<GraphChain> chain, pframes_t nframes, samplepos_t start_sample, samplepos_t end_sample, bool non_rt_pending);
-	int silence_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes);
 	int process_io_plugs (std::shared_ptr<GraphChain> chain, pframes_t nframes, samplepos_t start_sample);
 
 	bool     in_process_thread () const;
 	uint32_t n_threads () const;
 
+	/** Size the queues for a chain with @p n_nodes, not realtime safe */
+	void reserve_queues (size_t n_nodes);
+	bool     work_stealing () const { return _work_stealing.load (std::memory_order_relaxed); }
+
 	/* called by GraphNode */
 	void trigger (ProcessNode* n);
 	void reached_terminal_node ();
@@ -94,13 +154,21 @@ public:
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
 
+	/** statistics of the most recent cycle that used the work-stealing scheduler */
+	GraphSchedulerStats scheduler_stats () const;
+
 protected:
 	virtual void session_going_away ();
 
 private:
 	void reset_thread_list ();
+	void start_threads (uint32_t num_threads);
 	void drop_threads ();
+	bool process_unscheduled (GraphChain const*);
 	void run_one ();
+	void run_one_ws ();
+	bool find_work (GraphWorker*, ProcessNode*&);
+	void collect_scheduler_stats ();
 	void main_thread ();
 	void prep ();
 
@@ -109,6 +177,15 @@ private:
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
 	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
 
+	/** Capacity of the trigger queue and per-thread queues, only changed while no graph thread runs */
+	std::atomic<size_t> _queue_capacity;
+
+	/** Per-thread queues of the work-stealing scheduler, indexed by thread */
+	std::vector<GraphWorker*> _workers;
+
+	/** true if the current cycle uses the work-stealing scheduler */
+	std::atomic<bool> _work_stealing;
+
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
 
@@ -124,6 +201,12 @@ private:
 
 	bool _graph_empty;
 
+	/* work-stealing statistics of the last cycle */
+	std::atomic<uint32_t> _stat_steals;
+	std::atomic<uint32_t> _stat_sleeps;
+	std::atomic<uint32_t> _stat_idle_usec;
+	std::atomic<int64_t>  _cycle_start;
+
 	/* number of background worker threads >= 0 */
 	std::atomic<uint32_t> _n_workers;
 
@@ -140,7 +223,7 @@ private:
 	bool        _process_non_rt_pending;
 
 	enum ProcessMode {
-		Roll, NoRoll, Silence
+		Roll, NoRoll
 	} _process_mode;
 
 	int  _process_retval;
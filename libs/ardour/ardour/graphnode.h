@@ -55,17 +55,21 @@ public:
 	GraphActivision ();
 	virtual ~GraphActivision () {}
 
-	typedef std::map<GraphChain const*, node_set_t> ActivationMap;
-	typedef std::map<GraphChain const*, int>        RefCntMap;
+	typedef std::map<GraphChain const*, node_set_t>  ActivationMap;
+	typedef std::map<GraphChain const*, node_list_t> ActivationOrderMap;
+	typedef std::map<GraphChain const*, int>         RefCntMap;
 
-	node_set_t const& activation_set (GraphChain const* const g) const;
-	int               init_refcount (GraphChain const* const g) const;
+	node_set_t const&  activation_set (GraphChain const* const g) const;
+	node_list_t const& activation_order (GraphChain const* const g) const;
+	int                init_refcount (GraphChain const* const g) const;
 
 protected:
 	friend struct GraphChain;
 
 	/** Nodes that we directly feed */
 	SerializedRCUManager<ActivationMap> _activation_set;
+	/** Nodes that we directly feed, longest remaining critical-path first */
+	SerializedRCUManager<ActivationOrderMap> _activation_order;
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	SerializedRCUManager<RefCntMap> _init_refcount;
 };
@@ -79,12 +83,17 @@ public:
 	/* API used by Graph */
 	void prep (GraphChain const*);
 	void run (GraphChain const*);
+	/** process this node only, without triggering the nodes that it feeds */
+	void process_unscheduled () { process (); }
 
 	/* API used to sort Nodes and create GraphChain */
 	virtual std::string graph_node_name () const = 0;
 
 	virtual bool direct_feeds_according_to_reality (std::shared_ptr<GraphNode>, bool* via_send_only = 0) = 0;
 
+	/** Average time in usec that process() took during past cycles */
+	float dsp_cost () const { return _dsp_cost.load (std::memory_order_relaxed); }
+
 protected:
 	void trigger ();
 	virtual void process () = 0;
@@ -94,7 +103,8 @@ protected:
 private:
 	void finish (GraphChain const*);
 
-	std::atomic<int> _refcount;
+	std::atomic<int>   _refcount;
+	std::atomic<float> _dsp_cost;
 };
 
 } // namespace ARDOUR
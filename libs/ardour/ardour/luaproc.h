@@ -26,6 +26,7 @@
 #ifndef __ardour_luaproc_h__
 #define __ardour_luaproc_h__
 
+#include <atomic>
 #include <set>
 #include <vector>
 #include <string>
@@ -38,6 +39,7 @@
 #endif
 
 #include "pbd/stateful.h"
+#include "pbd/timing.h"
 
 #include "ardour/types.h"
 #include "ardour/plugin.h"
@@ -137,6 +139,18 @@ public:
 
 	std::map<std::string, FactoryPreset> _factory_presets;
 
+	/** Time spent in garbage collection, per GC step */
+	bool get_gc_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, double& dev) const;
+	/** Number of process cycles in which the adaptive GC did not run */
+	uint64_t gc_deferred_cycles () const { return _gc_deferred; }
+	/** Memory allocated by the interpreter, its high-water mark, and the arena size.
+	 * @return the number of allocations that failed because the arena was exhausted
+	 */
+	size_t get_memory_stats (size_t& used, size_t& peak, size_t& pool_size) const;
+	/** Number of allocations (including re-allocations) per process cycle */
+	bool get_alloc_stats (double& avg, size_t& max) const;
+	void clear_stats ();
+
 private:
 	samplecnt_t plugin_latency() const { return _signal_latency; }
 	void find_presets ();
@@ -156,6 +170,16 @@ private:
 #else
 	PBD::ReallocPool _mempool;
 #endif
+
+	static void* lalloc (void* self, void* ptr, size_t osize, size_t nsize);
+
+	/* memory accounting, must be initialized before the LuaState */
+	size_t   _mem_used;
+	size_t   _mem_peak;
+	size_t   _mem_failed;
+	size_t   _mem_allocs;
+	size_t   _mem_gc_debt;
+
 	LuaState lua;
 	luabridge::LuaRef * _lua_dsp;
 	luabridge::LuaRef * _lua_latency;
@@ -211,6 +235,17 @@ private:
 	bool _has_midi_input;
 	bool _has_midi_output;
 
+	void run_gc (pframes_t nframes);
+
+	bool              _gc_adaptive;
+	uint32_t          _gc_skipped;
+	uint64_t          _gc_deferred;
+	PBD::TimingStats  _gc_stats;
+	size_t            _allocs_cycle_start;
+	size_t            _allocs_max;
+	uint64_t          _allocs_sum;
+	uint64_t          _allocs_cnt;
+	std::atomic<int>  _stat_reset;
 
 #ifdef WITH_LUAPROC_STATS
 	int64_t _stats_avg[2];
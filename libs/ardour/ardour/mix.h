@@ -33,7 +33,11 @@ extern "C" {
 	LIBARDOUR_API void  x86_sse_mix_buffers_no_gain  (float* dst, float const* src, uint32_t nframes);
 }
 
-LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API void  x86_sse_find_peaks                  (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API float x86_sse_apply_gain_ramp             (float* buf, uint32_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  x86_sse_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_interleave_buffer           (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+LIBARDOUR_API void  x86_sse_deinterleave_buffer         (float* dst, float const* src, uint32_t nframes, uint32_t stride);
 
 extern "C" {
 /* AVX functions */
@@ -50,6 +54,9 @@ extern "C" {
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
 
+LIBARDOUR_API float x86_avx_apply_gain_ramp             (float* buf, uint32_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  x86_avx_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
+
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
@@ -82,6 +89,7 @@ LIBARDOUR_API void  veclib_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDOU
 LIBARDOUR_API void  veclib_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  veclib_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  veclib_find_peaks                (ARDOUR::Sample const* buf, ARDOUR::pframes_t nsamples, float* min, float* max);
+LIBARDOUR_API void  veclib_apply_gain_vector_to_buffer (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
 
 #endif
 
@@ -94,6 +102,10 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_find_peaks            (float const* src, uint32_t nframes, float* minf, float* maxf);
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
+	LIBARDOUR_API float arm_neon_apply_gain_ramp             (float* buf, uint32_t nframes, float gain, float target, float coeff);
+	LIBARDOUR_API void  arm_neon_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
+	LIBARDOUR_API void  arm_neon_interleave_buffer           (float* dst, float const* src, uint32_t nframes, uint32_t stride);
+	LIBARDOUR_API void  arm_neon_deinterleave_buffer         (float* dst, float const* src, uint32_t nframes, uint32_t stride);
 }
 #endif
 
@@ -105,5 +117,9 @@ LIBARDOUR_API void  default_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDO
 LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float default_apply_gain_ramp           (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  default_apply_gain_vector_to_buffer (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_interleave_buffer         (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t stride);
+LIBARDOUR_API void  default_deinterleave_buffer       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t stride);
 
 #endif /* __ardour_mix_h__ */
@@ -33,6 +33,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <sys/stat.h>
 
@@ -47,6 +48,7 @@
 #include "pbd/undo.h"
 
 #include "temporal/range.h"
+#include "temporal/tempo.h"
 
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
@@ -248,6 +250,12 @@ public:
 	virtual int set_state (const XMLNode&, int version);
 	XMLNode&    get_template ();
 
+	/** Like get_state(), but re-use a copy of the region state that was
+	 * serialized by the previous call, unless the region-list or any
+	 * region has changed since.
+	 */
+	XMLNode&    get_state_cached () const;
+
 	PBD::Signal1<void, bool>                     InUse;
 	PBD::Signal0<void>                           ContentsChanged;
 	PBD::Signal1<void, std::weak_ptr<Region> > RegionAdded;
@@ -329,10 +337,12 @@ protected:
 			if (block_notify) {
 				playlist->delay_notifications ();
 			}
+			playlist->region_index_write (true);
 		}
 
 		~RegionWriteLock ()
 		{
+			playlist->region_index_write (false);
 			Glib::Threads::RWLock::WriterLock::release ();
 			thawlist.release ();
 			if (block_notify) {
@@ -429,6 +439,7 @@ protected:
 	virtual void region_going_away (std::weak_ptr<Region> /*region*/);
 
 	virtual XMLNode& state (bool) const;
+	XMLNode& build_state (bool full_state, bool use_cache) const;
 
 	bool add_region_internal (std::shared_ptr<Region>, timepos_t const & position, ThawList& thawlist);
 
@@ -473,6 +484,49 @@ private:
 	void coalesce_and_check_crossfades (std::list<Temporal::TimeRange>);
 	std::shared_ptr<RegionList> find_regions_at (timepos_t const &);
 
+	/* Interval index over the extent of all regions, sorted by position.
+	 * Each entry also stores the largest end of the implicit balanced
+	 * sub-tree that is centered on it. This allows to find all regions
+	 * that overlap a given range in O(log N + K).
+	 *
+	 * The index is rebuilt lazily and only used while region-changes
+	 * are not postponed (see holding_state()).
+	 */
+	struct RegionIndexEntry {
+		superclock_t start;
+		superclock_t last;
+		superclock_t max_last;
+		Region*      region;
+
+		static bool start_less (RegionIndexEntry const& a, RegionIndexEntry const& b) { return a.start < b.start; }
+	};
+
+	typedef std::vector<RegionIndexEntry> RegionIndex;
+
+	void invalidate_region_index ();
+	void region_index_write (bool);
+	bool update_region_index () const;
+	static superclock_t build_region_index (RegionIndex&, size_t lo, size_t hi);
+
+	template <typename F> void foreach_region_in (timepos_t const & start, timepos_t const & end, F const & f) const;
+	template <typename F> void visit_region_index (size_t lo, size_t hi, superclock_t s, superclock_t e, F const & f) const;
+
+	mutable Glib::Threads::Mutex          _region_index_lock;
+	mutable RegionIndex                   _region_index;
+	mutable Temporal::TempoMap::SharedPtr _region_index_tempo_map;
+	mutable bool                          _region_index_valid;
+	bool                                  _region_index_writing;
+
+	/* region state cache for get_state_cached(), _region_state_gen
+	 * is incremented whenever the region-list or a region changes
+	 */
+	void invalidate_region_state ();
+
+	std::atomic<uint64_t>                 _region_state_gen;
+	mutable Glib::Threads::Mutex          _region_state_cache_lock;
+	mutable XMLNode*                      _region_state_cache;
+	mutable uint64_t                      _region_state_cache_gen;
+
 	mutable boost::optional<std::pair<timepos_t, timepos_t> > _cached_extent;
 	timepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 	bool _playlist_shift_active;
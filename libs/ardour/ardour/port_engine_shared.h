@@ -20,6 +20,7 @@
 #ifndef _libardour_port_engine_shared_h_
 #define _libardour_port_engine_shared_h_
 
+#include <algorithm>
 #include <atomic>
 #include <map>
 #include <memory>
@@ -50,6 +51,14 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 	BackendPort (PortEngineSharedImpl& b, const std::string&, PortFlags);
 
   public:
+	/** Flat list of connected ports, sorted by address.
+	 *
+	 * The list holds a reference to each connected port, so a
+	 * snapshot used by the process thread keeps its peers alive
+	 * even if they are unregistered meanwhile.
+	 */
+	typedef std::vector<BackendPortPtr> ConnectionList;
+
 	virtual ~BackendPort ();
 
 	const std::string& name ()        const { return _name; }
@@ -80,13 +89,16 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 	bool is_output ()    const { return flags () & IsOutput; }
 	bool is_physical ()  const { return flags () & IsPhysical; }
 	bool is_terminal ()  const { return flags () & IsTerminal; }
-	bool is_connected () const { return _connections.size () != 0; }
+	bool is_connected () const { return !_connections.reader ()->empty (); }
 
 	bool is_connected (BackendPortHandle port) const;
 	bool is_physically_connected () const;
 
-	const std::set<BackendPortPtr>& get_connections () const {
-		return _connections;
+	/** realtime safe, the list remains valid while the returned
+	 * pointer is held, even if connections change.
+	 */
+	std::shared_ptr<ConnectionList const> get_connections () const {
+		return _connections.reader ();
 	}
 
 	int  connect (BackendPortHandle port, BackendPortHandle self);
@@ -114,7 +126,8 @@ private:
 	const PortFlags        _flags;
 	LatencyRange           _capture_latency_range;
 	LatencyRange           _playback_latency_range;
-	std::set<BackendPortPtr> _connections;
+
+	SerializedRCUManager<ConnectionList> _connections;
 
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
@@ -221,9 +234,13 @@ protected:
 		}
 	};
 
-	typedef std::map<std::string, BackendPortPtr>    PortMap;       // fast-lookup by name
-	typedef std::set<BackendPortPtr, SortByPortName> PortIndex;     // name-based
-	typedef std::set<BackendPortPtr>                 PortRegistry;  // std::less<>, safe during rename
+	/* The port-index and registry are flat vectors, kept sorted
+	 * by name and address respectively. Lookups use binary search,
+	 * and scans (e.g. get_ports()) iterate over contiguous memory.
+	 */
+	typedef std::map<std::string, BackendPortPtr> PortMap;       // fast-lookup by name
+	typedef std::vector<BackendPortPtr>           PortIndex;     // sorted by name
+	typedef std::vector<BackendPortPtr>           PortRegistry;  // sorted by address, safe during rename
 
 	SerializedRCUManager<PortMap>      _portmap;
 	SerializedRCUManager<PortIndex>    _ports;
@@ -231,9 +248,14 @@ protected:
 
 	bool valid_port (BackendPortHandle port) const {
 		std::shared_ptr<PortRegistry const> p = _portregistry.reader ();
-		return p->find (port) != p->end ();
+		return std::binary_search (p->begin (), p->end (), port);
 	}
 
+	static void index_insert (PortIndex&, BackendPortHandle);
+	static bool index_erase (PortIndex&, BackendPortHandle);
+	static void registry_insert (PortRegistry&, BackendPortHandle);
+	static void registry_erase (PortRegistry&, BackendPortHandle);
+
 	BackendPortPtr find_port (const std::string& port_name) const {
 		std::shared_ptr<PortMap const> p  = _portmap.reader ();
 		PortMap::const_iterator        it = p->find (port_name);
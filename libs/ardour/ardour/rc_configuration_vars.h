@@ -76,6 +76,7 @@ CONFIG_VARIABLE (bool, first_midi_bank_is_zero, "display-first-midi-bank-as-zero
 CONFIG_VARIABLE (int32_t, inter_scene_gap_samples, "inter-scene-gap-samples", 1)
 CONFIG_VARIABLE (bool, midi_input_follows_selection, "midi-input-follows-selection", 1)
 CONFIG_VARIABLE (std::string, default_trigger_input_port, "default-trigger-input-port", "")
+CONFIG_VARIABLE (float, clip_stream_seconds, "clip-stream-seconds", 0) /* stream clips longer than this, 0: read whole clips */
 
 /* Timecode and related */
 
@@ -101,8 +102,10 @@ CONFIG_VARIABLE (BufferingPreset, buffering_preset, "buffering-preset", Medium)
 CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
+CONFIG_VARIABLE (uint32_t, butler_threads, "butler-threads", 1) /* number of threads for disk refill and write-behind */
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
+CONFIG_VARIABLE (bool, parallel_import, "parallel-import", false)
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
 CONFIG_VARIABLE (float, max_transport_speed, "max-transport-speed", 2.0)
 
@@ -220,6 +223,8 @@ CONFIG_VARIABLE (std::string, clip_library_dir, "clip-library-dir", "@default@")
 CONFIG_VARIABLE (std::string, sample_lib_path, "sample-lib-path", "") /* custom paths */
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (ProcessGraphScheduler, process_graph_scheduler, "process-graph-scheduler", SharedQueueScheduler)
+CONFIG_VARIABLE (int32_t, lv2_worker_threads, "lv2-worker-threads", 0) /* <= 0: automatic */
 CONFIG_VARIABLE (int32_t, cpu_dma_latency, "cpu-dma-latency", -1) /* >=0 to enable */
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
@@ -250,6 +255,7 @@ CONFIG_VARIABLE (bool, setup_sidechain, "setup-sidechain", false)
 CONFIG_VARIABLE (uint32_t, plugin_scan_timeout, "plugin-scan-timeout", 150) /* deci-seconds */
 CONFIG_VARIABLE (uint32_t, limit_n_automatables, "limit-n-automatables", 512)
 CONFIG_VARIABLE (uint32_t, plugin_cache_version, "plugin-cache-version", 0)
+CONFIG_VARIABLE (bool, lua_dsp_adaptive_gc, "lua-dsp-adaptive-gc", false)
 
 /* custom user plugin paths */
 CONFIG_VARIABLE (std::string, plugin_path_vst, "plugin-path-vst", "@default@")
@@ -285,4 +291,5 @@ CONFIG_VARIABLE (bool, show_video_server_dialog, "show-video-server-dialog", fal
 /* export */
 CONFIG_VARIABLE (float, export_preroll, "export-preroll", 2.0) // seconds
 CONFIG_VARIABLE (float, export_silence_threshold, "export-silence-threshold", -90) // dB
+CONFIG_VARIABLE (bool, export_parallel_encoding, "export-parallel-encoding", false) // encode all formats from a shared intermediate, in parallel
 CONFIG_VARIABLE (float, ppqn_factor_for_export, "ppqn-factor-for-export", 1) // Temporal::ticks_per_beat
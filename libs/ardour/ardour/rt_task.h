@@ -19,7 +19,8 @@
 #ifndef _ardour_rt_task_h_
 #define _ardour_rt_task_h_
 
-#include <boost/function.hpp>
+#include <new>
+#include <stdint.h>
 
 #include "ardour/graphnode.h"
 
@@ -28,18 +29,95 @@ namespace ARDOUR
 class Graph;
 class RTTaskList;
 
-class LIBARDOUR_API RTTask : public ProcessNode
+/** A callable that is stored in-place, without heap allocation.
+ *
+ * Any function object (usually a lambda) that fits into the fixed size
+ * storage can be assigned. This is checked at compile-time.
+ */
+class LIBARDOUR_API RTTask
+{
+public:
+	RTTask ()
+		: _invoke (0)
+		, _destroy (0)
+	{}
+
+	~RTTask ()
+	{
+		reset ();
+	}
+
+	template <typename F>
+	void set (F const& f)
+	{
+		static_assert (sizeof (F) <= sizeof (Storage), "RTTask: callable is too large");
+		static_assert (alignof (F) <= alignof (Storage), "RTTask: callable is over-aligned");
+		reset ();
+		new (&_storage) F (f);
+		_invoke  = &invoke<F>;
+		_destroy = &destroy<F>;
+	}
+
+	void reset ()
+	{
+		if (_destroy) {
+			_destroy (&_storage);
+		}
+		_invoke  = 0;
+		_destroy = 0;
+	}
+
+	void operator() ()
+	{
+		_invoke (&_storage);
+	}
+
+private:
+	RTTask (RTTask const&);
+	RTTask& operator= (RTTask const&);
+
+	template <typename F>
+	static void invoke (void* f)
+	{
+		(*static_cast<F*> (f)) ();
+	}
+
+	template <typename F>
+	static void destroy (void* f)
+	{
+		static_cast<F*> (f)->~F ();
+	}
+
+	union Storage {
+		char    data[48];
+		void*   align_p;
+		double  align_d;
+		int64_t align_i;
+	};
+
+	Storage _storage;
+	void (*_invoke) (void*);
+	void (*_destroy) (void*);
+};
+
+/** A contiguous range of RTTasks, processed by one graph thread */
+class LIBARDOUR_API RTTaskChunk : public ProcessNode
 {
 public:
-	RTTask (Graph* g, boost::function<void ()> const& fn);
+	RTTaskChunk ()
+		: _graph (0)
+		, _begin (0)
+		, _end (0)
+	{}
 
 	void prep (GraphChain const*) {}
 	void run (GraphChain const*);
 
 private:
 	friend class RTTaskList;
-	boost::function<void ()> _f;
-	Graph*                   _graph;
+	Graph*  _graph;
+	RTTask* _begin;
+	RTTask* _end;
 };
 
 }
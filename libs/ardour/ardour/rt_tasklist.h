@@ -19,8 +19,7 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
-#include <boost/function.hpp>
-#include <vector>
+#include <memory>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/rt_task.h"
@@ -32,17 +31,42 @@ class Graph;
 class LIBARDOUR_API RTTaskList
 {
 public:
-	RTTaskList (std::shared_ptr<Graph>);
+	RTTaskList (std::shared_ptr<Graph>, size_t capacity = 1024);
+	~RTTaskList ();
 
 	/** process tasks in list in parallel, wait for them to complete */
 	void process ();
-	void push_back (boost::function<void ()> fn);
 
-	std::vector<RTTask> const& tasks () const { return _tasks; }
+	/** add a task to the list. This does not allocate memory.
+	 * If the list is full, the task is executed immediately.
+	 */
+	template <typename F>
+	void push_back (F const& fn)
+	{
+		if (_n_tasks < _capacity) {
+			_tasks[_n_tasks++].set (fn);
+		} else {
+			fn ();
+		}
+	}
+
+	size_t size () const { return _n_tasks; }
+
+	RTTaskChunk* chunks () const { return _chunks; }
+	size_t n_chunks () const { return _n_chunks; }
 
 private:
-	std::vector<RTTask>      _tasks;
+	RTTaskList (RTTaskList const&);
+	RTTaskList& operator= (RTTaskList const&);
+
 	std::shared_ptr<Graph> _graph;
+
+	RTTask*      _tasks;
+	RTTaskChunk* _chunks;
+	size_t       _capacity;
+	size_t       _max_chunks;
+	size_t       _n_tasks;
+	size_t       _n_chunks;
 };
 
 } // namespace ARDOUR
@@ -32,12 +32,26 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 
+	/** apply a 1st order LPF'ed gain ramp from gain towards target, return the gain reached */
+	typedef float (*apply_gain_ramp_t)                (ARDOUR::Sample *, pframes_t, float gain, float target, float coeff);
+	/** multiply the buffer by a per-sample gain vector */
+	typedef void  (*apply_gain_vector_to_buffer_t)    (ARDOUR::Sample *, const ARDOUR::gain_t *, pframes_t);
+	/** dst[i * stride] = src[i] */
+	typedef void  (*interleave_buffer_t)              (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t stride);
+	/** dst[i] = src[i * stride] */
+	typedef void  (*deinterleave_buffer_t)            (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t stride);
+
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
 	LIBARDOUR_API extern apply_gain_to_buffer_t  apply_gain_to_buffer;
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+
+	LIBARDOUR_API extern apply_gain_ramp_t             apply_gain_ramp;
+	LIBARDOUR_API extern apply_gain_vector_to_buffer_t apply_gain_vector_to_buffer;
+	LIBARDOUR_API extern interleave_buffer_t           interleave_buffer;
+	LIBARDOUR_API extern deinterleave_buffer_t         deinterleave_buffer;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
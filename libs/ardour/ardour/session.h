@@ -111,6 +111,7 @@ namespace PBD {
 class Controllable;
 class Progress;
 class Command;
+class Thread;
 }
 
 namespace luabridge {
@@ -145,6 +146,7 @@ class CoreSelection;
 class ExportHandler;
 class ExportStatus;
 class Graph;
+struct GraphSchedulerStats;
 struct GraphChain;
 class IO;
 class IOPlug;
@@ -267,6 +269,9 @@ public:
 
 	static PBD::Signal1<void,std::string> Dialog;
 
+	/** Emitted at the start of each phase of loading a session, for profiling */
+	static PBD::Signal1<void,std::string> LoadPhase;
+
 	PBD::Signal0<void> BatchUpdateStart;
 	PBD::Signal0<void> BatchUpdateEnd;
 
@@ -357,6 +362,9 @@ public:
 	uint32_t nbusses () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
+	GraphSchedulerStats process_graph_scheduler_stats () const;
+	/** DSP-cost weighted longest path through the process graph, and sum of all nodes' cost [usec] */
+	bool process_graph_critical_path (double& critical_path, double& total_cost) const;
 
 	std::shared_ptr<BundleList const> bundles () {
 		return _bundles.reader ();
@@ -605,6 +613,16 @@ public:
 	                bool for_archive = false,
 	                bool only_used_assets = false);
 
+	/** save 'recovery' state of the current snapshot in the background.
+	 *
+	 * The state is collected in the calling thread, re-using serialized
+	 * region state of playlists that did not change since the last save.
+	 * Writing the file is done by a background thread.
+	 *
+	 * @return zero on success
+	 */
+	int save_state_async ();
+
 	enum ArchiveEncode {
 		NO_ENCODE,
 		FLAC_16BIT,
@@ -1634,6 +1652,15 @@ private:
 
 	Glib::Threads::Mutex save_state_lock;
 	Glib::Threads::Mutex save_source_lock;
+
+	PBD::Thread* _save_thread;
+	bool         _save_cached_state;
+
+	void wait_for_background_save ();
+	void remove_pending_state_file ();
+	void background_save (XMLTree*, std::string tmp_path, std::string xml_path, std::string backup_path);
+	int  write_state_file (XMLTree&, std::string const& tmp_path, std::string const& xml_path);
+	std::string pending_backup_path () const;
 	Glib::Threads::Mutex peak_cleanup_lock;
 
 	int        load_options (const XMLNode&);
@@ -1796,6 +1823,10 @@ private:
 	AutoConnectQueue     _auto_connect_queue;
 	std::atomic<unsigned int>   _latency_recompute_pending;
 
+	/* re-rank graph chains with measured DSP costs, requested periodically by process() */
+	std::atomic<unsigned int>   _graph_rank_pending;
+	samplecnt_t                 _graph_rank_countdown;
+
 	void get_physical_ports (std::vector<std::string>& inputs, std::vector<std::string>& outputs, DataType type,
 	                         MidiPortFlags include = MidiPortFlags (0),
 	                         MidiPortFlags exclude = MidiPortFlags (0));
@@ -2329,6 +2360,7 @@ private:
 
 	bool rechain_process_graph (GraphNodeList&);
 	bool rechain_ioplug_graph (bool);
+	void rank_process_graph ();
 
 	void ensure_route_presentation_info_gap (PresentationInfo::order_t, uint32_t gap_size);
 
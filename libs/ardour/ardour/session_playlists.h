@@ -86,7 +86,7 @@ private:
 
 	void find_equivalent_playlist_regions (std::shared_ptr<Region>, std::vector<std::shared_ptr<Region> >& result);
 	void update_after_tempo_map_change ();
-	void add_state (XMLNode*, bool save_template, bool include_unused) const;
+	void add_state (XMLNode*, bool save_template, bool include_unused, bool cached = false) const;
 	bool maybe_delete_unused (boost::function<int(std::shared_ptr<Playlist>)>);
 	int load (Session &, const XMLNode&);
 	int load_unused (Session &, const XMLNode&);
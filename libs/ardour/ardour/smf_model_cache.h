@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Ardour Community
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _libardour_smf_model_cache_h_
+#define _libardour_smf_model_cache_h_
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "evoral/SMF.h"
+#include "evoral/types.h"
+
+#include "temporal/beats.h"
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR
+{
+
+/** Binary cache of the events of a Standard MIDI File, as they are
+ * passed to the MidiModel: sorted by time, with times in Beats.
+ *
+ * The cache is stored next to the .mid file, and it is valid as long
+ * as the file's size and modification time match the ones recorded
+ * in the cache. It is memory-mapped for reading, so a model can be
+ * built from it without parsing the SMF.
+ */
+class LIBARDOUR_API SMFModelCache
+{
+public:
+	SMFModelCache (std::string const& smf_path);
+	~SMFModelCache ();
+
+	/** Map the cache file for reading.
+	 * @return false if there is no cache, or if it is stale
+	 */
+	bool open ();
+	void close ();
+
+	uint64_t                  n_note_on_events () const;
+	bool                      has_pgm_change () const;
+	Evoral::SMF::UsedChannels used_channels () const;
+	Temporal::Beats           length () const;
+
+	/** Return the next event of an opened cache. The event data
+	 * points into the mapped file, and is valid until close ().
+	 * @param id event-ID that was stored in the SMF, or -1
+	 * @return false when all events were read
+	 */
+	bool next_event (Temporal::Beats& time, Evoral::event_id_t& id, uint32_t& size, uint8_t const*& buf);
+
+	/** Append an event to be written, events must be added in the
+	 * order in which they are to be read back.
+	 */
+	void add_event (Temporal::Beats const& time, Evoral::event_id_t id, uint32_t size, uint8_t const* buf);
+
+	/** Write all added events, replacing any existing cache */
+	int write (uint64_t n_note_on_events, bool has_pgm_change, Evoral::SMF::UsedChannels const&, Temporal::Beats const& length);
+
+	static std::string cache_path (std::string const& smf_path);
+	static void remove (std::string const& smf_path);
+
+private:
+	struct Header;
+
+	bool stat_smf (int64_t& size, int64_t& mtime) const;
+
+	std::string          _smf_path;
+	uint8_t const*       _map_addr;
+	size_t               _map_length;
+	size_t               _read_offset;
+	int                  _fd;
+	std::vector<uint8_t> _data;
+};
+
+} // namespace ARDOUR
+
+#endif
@@ -57,6 +57,7 @@ public:
 	static std::vector<PBD::Thread*> peak_thread_pool;
 
 	static std::list<std::weak_ptr<AudioSource>> files_with_peaks;
+	static std::list<std::weak_ptr<AudioSource>> files_with_peak_levels;
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (std::shared_ptr<Source>, bool async);
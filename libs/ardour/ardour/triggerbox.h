@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
 #include <exception>
@@ -33,6 +34,7 @@
 #include "pbd/pcg_rand.h"
 #include "pbd/pool.h"
 #include "pbd/properties.h"
+#include "pbd/rcu.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/stateful.h"
 
@@ -482,6 +484,130 @@ class LIBARDOUR_API Trigger : public PBD::Stateful {
 	void send_property_change (PBD::PropertyChange pc);
 };
 
+/** Raw audio data of an AudioRegion, shared by all AudioTriggers that
+ * use the same sources and range.
+ *
+ * Long clips can be streamed: only the head of the clip is read when it
+ * is loaded, the rest is read in the background by the TriggerBoxThread.
+ * Triggers hold playback while the data they need has not been read yet.
+ * The buffers are allocated at full length, streaming reduces load time,
+ * not memory use.
+ */
+class LIBARDOUR_API AudioClipData
+{
+  public:
+	~AudioClipData ();
+
+	/** Return the data of @p region, reading it if it is not cached.
+	 * @param head_samples stream clips that are longer than this, 0 to read all data
+	 * @return 0 if the data cannot be read
+	 */
+	static std::shared_ptr<AudioClipData> get (std::shared_ptr<AudioRegion> region, samplecnt_t head_samples);
+
+	/** @return number of cached clips and their total size in bytes */
+	static size_t cache_size (size_t& bytes);
+
+	uint32_t    n_channels () const { return _channels.size (); }
+	Sample*     channel (uint32_t n) const { return _channels[n]; }
+	samplecnt_t length () const { return _length; }
+	samplecnt_t loaded () const { return _loaded.load (); }
+
+	/** MiniBPM estimate, computed once using the data read by get ().
+	 * For streamed clips this is only the head of the clip, so that all
+	 * triggers using the clip get the same estimate when it is loaded.
+	 */
+	double estimated_tempo (samplecnt_t sample_rate);
+
+	/** Read the next part of a streamed clip (called in the TriggerBoxThread).
+	 * @return true if there is more to read
+	 */
+	bool stream ();
+
+	/** A trigger plays the clip from @p pos, read ahead of it first (realtime safe) */
+	void want (samplepos_t pos) { _wanted.store (pos); }
+
+	/** @return true if the clip is played close to, or past the data read so far */
+	bool wanted () const;
+
+	/** A copy of the data that was time-stretched offline */
+	struct Stretched {
+		Stretched (uint32_t n_channels, samplecnt_t length, double ratio, Trigger::StretchMode);
+		~Stretched ();
+
+		std::vector<Sample*> channels;
+		samplecnt_t          length;
+		double               ratio;
+		Trigger::StretchMode mode;
+	};
+
+	typedef std::vector<std::shared_ptr<Stretched> > StretchedList;
+
+	/** Realtime safe, the returned list keeps its entries alive */
+	std::shared_ptr<StretchedList const> stretched () const { return _stretched.reader (); }
+	static Stretched const* find_stretched (StretchedList const&, double ratio, Trigger::StretchMode);
+
+	/** Request a stretched copy, to be rendered by the TriggerBoxThread.
+	 * This is realtime safe, a later request replaces a pending one.
+	 */
+	void request_stretch (double ratio, Trigger::StretchMode, samplecnt_t sample_rate);
+	bool stretch_requested () const { return _stretch_request.load () != 0; }
+
+	/** false if the clip could not be read completely, or a stretch could not be rendered */
+	bool stretchable () const { return _stretchable.load (); }
+
+	/** Render the next part of the pending stretch request (called in the TriggerBoxThread).
+	 * Requests for streamed clips are kept until the clip is read completely.
+	 * @return true if there is more to render
+	 */
+	bool render_stretch ();
+
+	/** @return clips with a pending stretch request or a render in progress */
+	static std::vector<std::shared_ptr<AudioClipData> > stretch_requests ();
+
+	/** Free stretched copies that were replaced and are no longer used by any trigger */
+	static void drop_unused_stretches ();
+
+  private:
+	struct Key {
+		Key (AudioRegion const&);
+		bool operator< (Key const&) const;
+
+		std::vector<PBD::ID> sources;
+		samplepos_t          start;
+		samplecnt_t          length;
+	};
+
+	typedef std::map<Key, std::weak_ptr<AudioClipData> > Cache;
+
+	struct StretchRender;
+
+	AudioClipData (std::shared_ptr<AudioRegion>);
+	void read (samplecnt_t cnt);
+	void read_head (samplecnt_t head_samples);
+	bool start_stretch ();
+	void finish_stretch ();
+
+	std::vector<Sample*>         _channels;
+	samplecnt_t                  _length;
+	samplecnt_t                  _head;
+	std::atomic<samplecnt_t>     _loaded;
+	std::atomic<samplepos_t>     _wanted; /* -1: not played while streaming */
+	std::shared_ptr<AudioRegion> _region; /* while streaming */
+	Glib::Threads::Mutex         _read_lock; /* held while get () reads the head */
+	bool                         _read_failed;
+	double                       _tempo;
+	Glib::Threads::Mutex         _tempo_lock;
+
+	SerializedRCUManager<StretchedList> _stretched;
+	std::atomic<int64_t>                _stretch_request; /* ratio and mode, 0: none */
+	std::atomic<samplecnt_t>            _stretch_rate;
+	std::atomic<bool>                   _stretchable;
+	std::unique_ptr<StretchRender>      _render; /* TriggerBoxThread only */
+
+	static Cache                 _cache;
+	static Glib::Threads::Mutex  _cache_lock;
+};
+
 class LIBARDOUR_API AudioTrigger : public Trigger {
   public:
 	AudioTrigger (uint32_t index, TriggerBox&);
@@ -536,6 +662,7 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
   private:
 	struct Data : std::vector<Sample*> {
 		samplecnt_t length;
+		std::shared_ptr<AudioClipData> clip;
 
 		Data () : length (0) {}
 	};
@@ -544,6 +671,12 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	RubberBand::RubberBandStretcher*  _stretcher;
 	samplepos_t _start_offset;
 
+	/* pre-rendered stretch used instead of _stretcher, if any */
+	std::shared_ptr<AudioClipData::StretchedList const> _stretched_list;
+	AudioClipData::Stretched const* _stretched;
+	samplepos_t _stretched_index;
+	bool        _select_stretched;
+
 
 	/* computed during run */
 
@@ -554,6 +687,7 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	samplecnt_t got_stretcher_padding;
 	samplecnt_t to_pad;
 	samplecnt_t to_drop;
+	bool        stretcher_preroll;
 
 	virtual void setup_stretcher ();
 
@@ -561,6 +695,8 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	int load_data (std::shared_ptr<AudioRegion>);
 	void estimate_tempo ();
 	void reset_stretcher ();
+	void use_stretched (double bpm);
+	void release_stretched ();
 	void _startup (BufferSet&, pframes_t dest_offset, Temporal::BBT_Offset const &);
 };
 
@@ -659,8 +795,13 @@ class LIBARDOUR_API TriggerBoxThread
 
 	void set_region (TriggerBox&, uint32_t slot, std::shared_ptr<Region>);
 	void request_delete_trigger (Trigger* t);
+	void stream_clip (std::weak_ptr<AudioClipData>);
 
 	void summon();
+	/** wake up to render stretches requested with AudioClipData::request_stretch (), realtime safe */
+	void request_stretch ();
+	/** wake up to free stretched copies that are no longer used, realtime safe */
+	void release_stretch ();
 	void stop();
 	void wait_until_finished();
 
@@ -671,7 +812,10 @@ class LIBARDOUR_API TriggerBoxThread
 	enum RequestType {
 		Quit,
 		SetRegion,
-		DeleteTrigger
+		DeleteTrigger,
+		StreamClip,
+		RenderStretch,
+		ReleaseStretch
 	};
 
 	struct Request {
@@ -699,6 +843,13 @@ class LIBARDOUR_API TriggerBoxThread
 	CrossThreadChannel _xthread;
 	void queue_request (Request*);
 	void delete_trigger (Trigger*);
+
+	/* clips to be streamed are added by other threads to _new_streams */
+	std::vector<std::weak_ptr<AudioClipData> > _new_streams;
+	std::vector<std::weak_ptr<AudioClipData> > _streams;
+	Glib::Threads::Mutex                        _stream_lock;
+	bool stream_clips ();
+	bool render_stretches ();
 };
 
 struct CueRecord {
@@ -713,6 +713,11 @@ struct CleanupReport {
 	size_t                   space;
 };
 
+enum ProcessGraphScheduler {
+	SharedQueueScheduler,
+	WorkStealingScheduler
+};
+
 enum PluginGUIBehavior {
 	PluginGUIHide,
 	PluginGUIDestroyAny,
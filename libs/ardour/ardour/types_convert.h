@@ -81,6 +81,7 @@ DEFINE_ENUM_CONVERT(ARDOUR::RegionEquivalence)
 DEFINE_ENUM_CONVERT(ARDOUR::WaveformScale)
 DEFINE_ENUM_CONVERT(ARDOUR::WaveformShape)
 DEFINE_ENUM_CONVERT(ARDOUR::ScreenSaverMode)
+DEFINE_ENUM_CONVERT(ARDOUR::ProcessGraphScheduler)
 DEFINE_ENUM_CONVERT(ARDOUR::PluginGUIBehavior)
 DEFINE_ENUM_CONVERT(ARDOUR::AppleNSGLViewMode)
 DEFINE_ENUM_CONVERT(ARDOUR::VUMeterStandard)
@@ -21,6 +21,7 @@
 #ifndef __ardour_worker_h__
 #define __ardour_worker_h__
 
+#include <atomic>
 #include <stdint.h>
 
 #include "pbd/pthread_utils.h"
@@ -32,6 +33,7 @@
 namespace ARDOUR {
 
 class Worker;
+class WorkerPool;
 
 /**
    An object that needs to schedule non-RT work in the audio thread.
@@ -54,9 +56,13 @@ public:
 /**
    A worker for non-realtime tasks scheduled from another thread.
 
-   A worker may be a separate thread that runs to execute scheduled work
-   asynchronously, or unthreaded, in which case work is executed immediately
-   upon scheduling by the calling thread.
+   A worker may be threaded, in which case scheduled work is executed
+   asynchronously by a pool of threads that is shared by all workers,
+   or unthreaded, in which case work is executed immediately upon
+   scheduling by the calling thread.
+
+   Work scheduled for a given worker is executed in order, by at most
+   one pool thread at a time.
 */
 class LIBARDOUR_API Worker
 {
@@ -92,7 +98,15 @@ public:
 	void set_synchronous(bool synchronous) { _synchronous = synchronous; }
 
 private:
-	void run();
+	friend class WorkerPool;
+
+	/** Execute all pending requests (pool thread).
+	 * @param buf per thread buffer for the request body, grown as needed
+	 * @param buf_size allocated size of @p buf
+	 */
+	void drain(void*& buf, size_t& buf_size);
+	/** Queue this worker for a pool thread, unless it is queued already (audio thread) */
+	void queue();
 	/**
 	   Peek in RB, get size and check if a block of 'size' is available.
 
@@ -108,9 +122,8 @@ private:
 	PBD::RingBuffer<uint8_t>* _requests;
 	PBD::RingBuffer<uint8_t>* _responses;
 	uint8_t*                  _response;
-	PBD::Semaphore            _sem;
-	PBD::Thread*              _thread;
-	bool                      _exit;
+	std::atomic<bool>         _queued;
+	std::atomic<int>          _draining;
 	bool                      _synchronous;
 };
 
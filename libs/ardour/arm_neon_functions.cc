@@ -515,4 +515,112 @@ arm_neon_copy_vector(
 	}
 }
 
+C_FUNC float
+arm_neon_apply_gain_ramp(float *buf, uint32_t nframes, float gain, float target, float coeff)
+{
+	// gain[n] = target + (gain - target) * (1 - coeff)^n
+	const float k  = 1.f - coeff;
+	const float k2 = k * k;
+	const float kn[4] = { 1.f, k, k2, k2 * k };
+
+	float32x4_t vkn = vld1q_f32(kn);
+	float32x4_t vk4 = vdupq_n_f32(k2 * k2);
+	float32x4_t vt  = vdupq_n_f32(target);
+	float32x4_t vd  = vdupq_n_f32(gain - target);
+
+	while (nframes >= 4) {
+		float32x4_t g  = vmlaq_f32(vt, vd, vkn);
+		float32x4_t x0 = vld1q_f32(buf);
+		vst1q_f32(buf, vmulq_f32(x0, g));
+		vd = vmulq_f32(vd, vk4);
+
+		buf += 4;
+		nframes -= 4;
+	}
+
+	gain = target + vgetq_lane_f32(vd, 0);
+
+	// Do the remaining samples
+	while (nframes > 0) {
+		*buf++ *= gain;
+		gain += coeff * (target - gain);
+		--nframes;
+	}
+	return gain;
+}
+
+C_FUNC void
+arm_neon_apply_gain_vector_to_buffer(float *buf, const float *gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		float32x4_t x0, x1, g0, g1;
+
+		x0 = vld1q_f32(buf + 0);
+		x1 = vld1q_f32(buf + 4);
+		g0 = vld1q_f32(gain + 0);
+		g1 = vld1q_f32(gain + 4);
+
+		vst1q_f32(buf + 0, vmulq_f32(x0, g0));
+		vst1q_f32(buf + 4, vmulq_f32(x1, g1));
+
+		buf += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	// Do the remaining samples
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
+
+C_FUNC void
+arm_neon_interleave_buffer(float *dst, const float *src, uint32_t nframes, uint32_t stride)
+{
+	if (stride == 2) {
+		// stereo, keep the samples of the other channel. Each pass
+		// accesses 8 slots, but the last frame of a group only needs 7:
+		// the final group is left to the scalar loop, so that a
+		// channel offset in dst does not write past the end.
+		while (nframes > 4) {
+			float32x4x2_t d = vld2q_f32(dst);
+			d.val[0] = vld1q_f32(src);
+			vst2q_f32(dst, d);
+
+			src += 4;
+			dst += 8;
+			nframes -= 4;
+		}
+	}
+
+	while (nframes > 0) {
+		*dst = *src++;
+		dst += stride;
+		--nframes;
+	}
+}
+
+C_FUNC void
+arm_neon_deinterleave_buffer(float *dst, const float *src, uint32_t nframes, uint32_t stride)
+{
+	if (stride == 2) {
+		// see arm_neon_interleave_buffer, do not read past the end
+		while (nframes > 4) {
+			float32x4x2_t s = vld2q_f32(src);
+			vst1q_f32(dst, s.val[0]);
+
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	}
+
+	while (nframes > 0) {
+		*dst++ = *src;
+		src += stride;
+		--nframes;
+	}
+}
+
 #endif
@@ -46,6 +46,8 @@ AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 	: sample_rate (sr)
 	, plugin_key (key)
 {
+	_cancel.store (0);
+
 	/* create VAMP plugin and initialize */
 
 	if (initialize_plugin (plugin_key, sample_rate)) {
@@ -118,6 +120,10 @@ AudioAnalyser::analyse (const string& path, AudioReadable* src, uint32_t channel
 
 	while (!done) {
 
+		if (_cancel.load ()) {
+			goto out;
+		}
+
 		samplecnt_t to_read;
 
 		/* read from source */
@@ -190,6 +190,10 @@ AudioRegion::make_property_quarks ()
 void
 AudioRegion::register_properties ()
 {
+	for (int i = 0; i < NumGainCurves; ++i) {
+		_gain_curve_generation[i].store (0);
+	}
+
 	/* no need to register parent class properties */
 
 	add_property (_envelope_active);
@@ -416,6 +420,8 @@ AudioRegion::listen_to_my_curves ()
 	_envelope->StateChanged.connect_same_thread (*this, boost::bind (&AudioRegion::envelope_changed, this));
 	_fade_in->StateChanged.connect_same_thread (*this, boost::bind (&AudioRegion::fade_in_changed, this));
 	_fade_out->StateChanged.connect_same_thread (*this, boost::bind (&AudioRegion::fade_out_changed, this));
+	_inverse_fade_in->StateChanged.connect_same_thread (*this, boost::bind (&AudioRegion::invalidate_gain_curve, this, InverseFadeInCurve));
+	_inverse_fade_out->StateChanged.connect_same_thread (*this, boost::bind (&AudioRegion::invalidate_gain_curve, this, InverseFadeOutCurve));
 }
 
 void
@@ -548,11 +554,14 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 
 	samplecnt_t fade_interval_start = 0;
 
+	samplecnt_t fade_in_length  = 0;
+	samplecnt_t fade_out_length = 0;
+
 	/* Fade in */
 
 	if (_fade_in_active && _session.config.get_use_region_fades()) {
 
-		samplecnt_t fade_in_length = _fade_in->when(false).samples();
+		fade_in_length = _fade_in->when(false).samples();
 
 		/* see if this read is within the fade in */
 
@@ -584,7 +593,8 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 		 *
 		 */
 
-		fade_interval_start = max (internal_offset, lsamples - _fade_out->when(false).samples());
+		fade_out_length = _fade_out->when(false).samples();
+		fade_interval_start = max (internal_offset, lsamples - fade_out_length);
 		samplecnt_t fade_interval_end = min(internal_offset + to_read, lsamples);
 
 		if (fade_interval_end > fade_interval_start) {
@@ -607,16 +617,13 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 	/* APPLY REGULAR GAIN CURVES AND SCALING TO mixdown_buffer */
 
 	if (envelope_active())  {
-		_envelope->curve().get_vector (timepos_t (internal_offset), timepos_t (internal_offset + to_read), gain_buffer, to_read);
+		std::shared_ptr<const RenderedGainCurve> rc;
+		gain_t const* gain = gain_curve (EnvelopeCurve, *_envelope.val(), lsamples, internal_offset, to_read, gain_buffer, rc);
+
+		apply_gain_vector_to_buffer (mixdown_buffer, gain, to_read);
 
 		if (_scale_amplitude != 1.0f) {
-			for (samplecnt_t n = 0; n < to_read; ++n) {
-				mixdown_buffer[n] *= gain_buffer[n] * _scale_amplitude;
-			}
-		} else {
-			for (samplecnt_t n = 0; n < to_read; ++n) {
-				mixdown_buffer[n] *= gain_buffer[n];
-			}
+			apply_gain_to_buffer (mixdown_buffer, to_read, _scale_amplitude);
 		}
 	} else if (_scale_amplitude != 1.0f) {
 		apply_gain_to_buffer (mixdown_buffer, to_read, _scale_amplitude);
@@ -633,6 +640,9 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 
 	if (fade_in_limit != 0) {
 
+		std::shared_ptr<const RenderedGainCurve> rc;
+		gain_t const* gain;
+
 		if (is_opaque) {
 			if (_inverse_fade_in) {
 
@@ -640,16 +650,15 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 				 * power), so we have to fetch it.
 				 */
 
-				_inverse_fade_in->curve().get_vector (timepos_t (internal_offset), timepos_t (internal_offset + fade_in_limit), gain_buffer, fade_in_limit);
+				std::shared_ptr<const RenderedGainCurve> irc;
+				gain = gain_curve (InverseFadeInCurve, *_inverse_fade_in.val(), fade_in_length, internal_offset, fade_in_limit, gain_buffer, irc);
 
 				/* Fade the data from lower layers out */
-				for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-					buf[n] *= gain_buffer[n];
-				}
+				apply_gain_vector_to_buffer (buf, gain, fade_in_limit);
 
 				/* refill gain buffer with the fade in */
 
-				_fade_in->curve().get_vector (timepos_t (internal_offset), timepos_t (internal_offset + fade_in_limit), gain_buffer, fade_in_limit);
+				gain = gain_curve (FadeInCurve, *_fade_in.val(), fade_in_length, internal_offset, fade_in_limit, gain_buffer, rc);
 
 			} else {
 
@@ -657,19 +666,19 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 				 * in) for the fade out of lower layers
 				 */
 
-				_fade_in->curve().get_vector (timepos_t (internal_offset), timepos_t (internal_offset + fade_in_limit), gain_buffer, fade_in_limit);
+				gain = gain_curve (FadeInCurve, *_fade_in.val(), fade_in_length, internal_offset, fade_in_limit, gain_buffer, rc);
 
 				for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-					buf[n] *= 1 - gain_buffer[n];
+					buf[n] *= 1 - gain[n];
 				}
 			}
 		} else {
-			_fade_in->curve().get_vector (timepos_t (internal_offset), timepos_t (internal_offset + fade_in_limit), gain_buffer, fade_in_limit);
+			gain = gain_curve (FadeInCurve, *_fade_in.val(), fade_in_length, internal_offset, fade_in_limit, gain_buffer, rc);
 		}
 
 		/* Mix our newly-read data in, with the fade */
 		for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-			buf[n] += mixdown_buffer[n] * gain_buffer[n];
+			buf[n] += mixdown_buffer[n] * gain[n];
 		}
 	}
 
@@ -677,19 +686,21 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 
 		samplecnt_t const curve_offset = fade_interval_start - _fade_out->when(false).distance (len_as_tpos ()).samples();
 
+		std::shared_ptr<const RenderedGainCurve> rc;
+		gain_t const* gain;
+
 		if (is_opaque) {
 			if (_inverse_fade_out) {
 
-				_inverse_fade_out->curve().get_vector (timepos_t (curve_offset), timepos_t (curve_offset + fade_out_limit), gain_buffer, fade_out_limit);
+				std::shared_ptr<const RenderedGainCurve> irc;
+				gain = gain_curve (InverseFadeOutCurve, *_inverse_fade_out.val(), fade_out_length, curve_offset, fade_out_limit, gain_buffer, irc);
 
 				/* Fade the data from lower levels in */
-				for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-					buf[m] *= gain_buffer[n];
-				}
+				apply_gain_vector_to_buffer (buf + fade_out_offset, gain, fade_out_limit);
 
 				/* fetch the actual fade out */
 
-				_fade_out->curve().get_vector (timepos_t (curve_offset), timepos_t (curve_offset + fade_out_limit), gain_buffer, fade_out_limit);
+				gain = gain_curve (FadeOutCurve, *_fade_out.val(), fade_out_length, curve_offset, fade_out_limit, gain_buffer, rc);
 
 			} else {
 
@@ -698,21 +709,21 @@ AudioRegion::read_at (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 				 * out) for the fade in of lower layers
 				 */
 
-				_fade_out->curve().get_vector (timepos_t (curve_offset), timepos_t (curve_offset + fade_out_limit), gain_buffer, fade_out_limit);
+				gain = gain_curve (FadeOutCurve, *_fade_out.val(), fade_out_length, curve_offset, fade_out_limit, gain_buffer, rc);
 
 				for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-					buf[m] *= 1 - gain_buffer[n];
+					buf[m] *= 1 - gain[n];
 				}
 			}
 		} else {
-			_fade_out->curve().get_vector (timepos_t (curve_offset), timepos_t (curve_offset + fade_out_limit), gain_buffer, fade_out_limit);
+			gain = gain_curve (FadeOutCurve, *_fade_out.val(), fade_out_length, curve_offset, fade_out_limit, gain_buffer, rc);
 		}
 
 		/* Mix our newly-read data with whatever was already there,
 		   with the fade out applied to our data.
 		*/
 		for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-			buf[m] += mixdown_buffer[m] * gain_buffer[n];
+			buf[m] += mixdown_buffer[m] * gain[n];
 		}
 	}
 
@@ -1565,21 +1576,88 @@ AudioRegion::normalize (float max_amplitude, float target_dB)
 void
 AudioRegion::fade_in_changed ()
 {
+	invalidate_gain_curve (FadeInCurve);
+	invalidate_gain_curve (InverseFadeInCurve);
 	send_change (PropertyChange (Properties::fade_in));
 }
 
 void
 AudioRegion::fade_out_changed ()
 {
+	invalidate_gain_curve (FadeOutCurve);
+	invalidate_gain_curve (InverseFadeOutCurve);
 	send_change (PropertyChange (Properties::fade_out));
 }
 
 void
 AudioRegion::envelope_changed ()
 {
+	invalidate_gain_curve (EnvelopeCurve);
 	send_change (PropertyChange (Properties::envelope));
 }
 
+void
+AudioRegion::invalidate_gain_curve (GainCurve which)
+{
+	/* a read that is in progress may still store a curve rendered
+	 * from the old state, it is rejected by the generation.
+	 */
+	_gain_curve_generation[which].fetch_add (1);
+	std::atomic_store (&_gain_curve[which], std::shared_ptr<RenderedGainCurve> ());
+}
+
+/** @return the given curve rendered from 0 to @p length, with @p length
+ * values, or a null pointer if the curve is too long to be cached.
+ */
+std::shared_ptr<const AudioRegion::RenderedGainCurve>
+AudioRegion::rendered_gain_curve (GainCurve which, AutomationList const& list, samplecnt_t length) const
+{
+	/* 1MB per curve, longer curves are evaluated for every read */
+	static const samplecnt_t max_length = 262144;
+
+	if (length <= 0 || length > max_length || list.time_domain () != Temporal::AudioTime) {
+		return std::shared_ptr<const RenderedGainCurve> ();
+	}
+
+	uint32_t const generation = _gain_curve_generation[which].load ();
+
+	std::shared_ptr<RenderedGainCurve> rc = std::atomic_load (&_gain_curve[which]);
+
+	if (rc && rc->generation == generation && rc->length == length && rc->list == &list && rc->sample_rate == TEMPORAL_SAMPLE_RATE) {
+		return rc;
+	}
+
+	rc.reset (new RenderedGainCurve (length));
+	rc->generation  = generation;
+	rc->list        = &list;
+	rc->sample_rate = TEMPORAL_SAMPLE_RATE;
+
+	/* same as evaluating the curve for a single read of the complete
+	 * range, which is what read_at() did for short fades.
+	 */
+	list.curve().get_vector (timepos_t (0), timepos_t (length), rc->gain, length);
+
+	std::atomic_store (&_gain_curve[which], rc);
+	return rc;
+}
+
+/** @return @p n gain coefficients of the given curve, starting at @p offset.
+ * The returned pointer is either into the rendered curve (kept alive by
+ * @p rc) or @p gain_buffer, if the curve cannot be cached.
+ */
+gain_t const*
+AudioRegion::gain_curve (GainCurve which, AutomationList const& list, samplecnt_t length, sampleoffset_t offset, samplecnt_t n, gain_t* gain_buffer, std::shared_ptr<const RenderedGainCurve>& rc) const
+{
+	rc = rendered_gain_curve (which, list, length);
+
+	if (rc && offset >= 0 && offset + n <= rc->length) {
+		return rc->gain + offset;
+	}
+
+	list.curve().get_vector (timepos_t (offset), timepos_t (offset + n), gain_buffer, n);
+	return gain_buffer;
+}
+
 void
 AudioRegion::suspend_fade_in ()
 {
@@ -79,6 +79,9 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+/* samples per peak of the sidecar levels, each a 16:1 reduction of the level below */
+static const samplecnt_t peak_level_fpp[] = { 4096, 65536 };
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _peak_byte_max (0)
@@ -92,7 +95,13 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _last_fpp (0)
 {
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		_peak_level_fd[l] = -1;
+		_peak_level_byte_max[l] = 0;
+		_peak_level_acc_pos[l] = -1;
+	}
 }
 
 AudioSource::AudioSource (Session& s, const XMLNode& node)
@@ -108,7 +117,13 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _last_fpp (0)
 {
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		_peak_level_fd[l] = -1;
+		_peak_level_byte_max[l] = 0;
+		_peak_level_acc_pos[l] = -1;
+	}
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
 	}
@@ -130,6 +145,8 @@ AudioSource::~AudioSource ()
 		_peakfile_fd = -1;
 	}
 
+	close_peak_levels ();
+
 	delete [] peak_leftovers;
 }
 
@@ -211,6 +228,14 @@ AudioSource::touch_peakfile ()
 	tbuf.modtime = time ((time_t*) 0);
 
 	g_utime (_peakpath.c_str(), &tbuf);
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		std::string const lpath = peak_level_path (l);
+		if (g_stat (lpath.c_str(), &statbuf) == 0) {
+			tbuf.actime = statbuf.st_atime;
+			g_utime (lpath.c_str(), &tbuf);
+		}
+	}
 }
 
 int
@@ -229,6 +254,16 @@ AudioSource::rename_peakfile (string newpath)
 
 	_peakpath = newpath;
 
+	/* levels are only a cache, drop them if they cannot be moved along */
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		string const oldlevel = oldpath + string_compose (".%1", peak_level_fpp[l]);
+		if (Glib::file_test (oldlevel, Glib::FILE_TEST_EXISTS)) {
+			if (g_rename (oldlevel.c_str(), peak_level_path (l).c_str()) != 0) {
+				::g_unlink (oldlevel.c_str());
+			}
+		}
+	}
+
 	return 0;
 }
 
@@ -303,6 +338,10 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 		}
 	}
 
+	/* peakfiles written by older versions lack the coarser levels, they
+	 * are derived from the peakfile in the background, see
+	 * SourceFactory::setup_peakfile(). Until then reads use the peakfile.
+	 */
 	if (!empty() && !_peaks_built && _build_missing_peakfiles && _build_peakfiles) {
 		build_peaks_from_scratch ();
 	}
@@ -408,14 +447,28 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 	samplecnt_t zero_fill = 0;
 
 	GStatBuf statbuf;
+	std::string peakpath = _peakpath;
+
+	/* use the coarsest level that still has at least the requested
+	 * resolution, so that zoomed-out views read a bounded amount of data.
+	 */
+	if (samples_per_file_peak == _FPP) {
+		for (int l = n_peak_levels - 1; l >= 0; --l) {
+			if (samples_per_visual_peak >= peak_level_fpp[l] && peak_level_valid (l, min (start + cnt, _length.samples()))) {
+				peakpath = peak_level_path (l);
+				samples_per_file_peak = peak_level_fpp[l];
+				break;
+			}
+		}
+	}
 
 	expected_peaks = (cnt / (double) samples_per_file_peak);
-	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
+	if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
-	if (!_captured_for.empty()) {
+	if (!_captured_for.empty() && peakpath == _peakpath) {
 
 		/* _captured_for is only set after a capture pass is
 		 * complete. so we know that capturing is finished for this
@@ -432,12 +485,12 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		const off_t expected_file_size = (_length.samples() / (double) samples_per_file_peak) * sizeof (PeakData);
 
 		if (statbuf.st_size < expected_file_size) {
-			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), _peakpath, expected_file_size, statbuf.st_size) << endmsg;
+			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), peakpath, expected_file_size, statbuf.st_size) << endmsg;
 			lm.release(); // build_peaks_from_scratch() takes _lock
 			const_cast<AudioSource*>(this)->build_peaks_from_scratch ();
 			lm.acquire ();
-			if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), _peakpath, strerror (errno)) << endmsg;
+			if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), peakpath, strerror (errno)) << endmsg;
 			}
 			if (statbuf.st_size < expected_file_size) {
 				fatal << "peak file is still truncated after rebuild" << endmsg;
@@ -446,10 +499,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		}
 	}
 
-	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str(), O_RDONLY, 0444));
 
 	if (sfd < 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -457,7 +510,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 
 	DEBUG_TRACE (DEBUG::Peaks, string_compose (" ======>RP: npeaks = %1 start = %2 cnt = %3 len = %4 samples_per_visual_peak = %5 expected was %6 ... scale =  %7 PD ptr = %8 pf = %9\n"
-			, npeaks, start, cnt, _length, samples_per_visual_peak, expected_peaks, scale, peaks, _peakpath));
+			, npeaks, start, cnt, _length, samples_per_visual_peak, expected_peaks, scale, peaks, peakpath));
 
 	/* fix for near-end-of-file conditions */
 
@@ -509,7 +562,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		off_t  map_delta = map_off - read_map_off;
 		size_t map_length = bytes_to_read + map_delta;
 
-		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
+		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			char* addr;
 #ifdef PLATFORM_WINDOWS
@@ -520,13 +573,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -537,13 +590,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -556,6 +609,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = bytes_to_read;
 		}
@@ -602,7 +656,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		size_t raw_map_length = chunksize * sizeof(PeakData);
 		size_t map_length = (chunksize * sizeof(PeakData)) + map_delta;
 
-		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
+		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			boost::scoped_array<PeakData> staging (new PeakData[chunksize]);
 
@@ -615,13 +669,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -632,13 +686,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -674,6 +728,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = raw_map_length;
 		}
@@ -780,6 +835,8 @@ AudioSource::build_peaks_from_scratch ()
 
 		WriterLock lp (_lock);
 
+		remove_peak_levels ();
+
 		if (prepare_for_peakfile_writes ()) {
 			goto out;
 		}
@@ -835,6 +892,7 @@ AudioSource::build_peaks_from_scratch ()
 	if (ret) {
 		DEBUG_TRACE (DEBUG::Peaks, string_compose("Could not write peak data, attempting to remove peakfile %1\n", _peakpath));
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 
 	return ret;
@@ -850,6 +908,7 @@ AudioSource::close_peakfile ()
 	}
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 	_peaks_built = false;
 	return 0;
@@ -866,6 +925,10 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+
+	/* without levels, reads just fall back to the peakfile itself */
+	open_peak_levels ();
+
 	return 0;
 }
 
@@ -877,6 +940,7 @@ AudioSource::done_with_peakfile_writes (bool done)
 			close (_peakfile_fd);
 			_peakfile_fd = -1;
 		}
+		close_peak_levels ();
 		return;
 	}
 
@@ -889,6 +953,8 @@ AudioSource::done_with_peakfile_writes (bool done)
 		_peakfile_fd = -1;
 	}
 
+	close_peak_levels ();
+
 	if (done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
@@ -955,6 +1021,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, sam
 
 			_peak_byte_max = max (_peak_byte_max, (off_t) (byte + sizeof(PeakData)));
 
+			if (fpp == _FPP) {
+				update_peak_levels (0, &x, byte / sizeof (PeakData), 1);
+			}
+
 			{
 				Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 				PeakRangeReady (peak_leftover_sample, peak_leftover_cnt); /* EMIT SIGNAL */
@@ -1083,6 +1153,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, sam
 
 	_peak_byte_max = max (_peak_byte_max, (off_t) (first_peak_byte + bytes_to_write));
 
+	if (fpp == _FPP) {
+		update_peak_levels (0, peakbuf.get(), first_peak_byte / sizeof (PeakData), peaks_computed);
+	}
+
 	if (samples_done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		PeakRangeReady (first_sample, samples_done); /* EMIT SIGNAL */
@@ -1114,6 +1188,250 @@ AudioSource::truncate_peakfile ()
 						 _peakpath, _peak_byte_max, errno) << endmsg;
 		}
 	}
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		if (-1 == _peak_level_fd[l]) {
+			continue;
+		}
+		if (lseek (_peak_level_fd[l], 0, SEEK_END) > _peak_level_byte_max[l]) {
+			if (ftruncate (_peak_level_fd[l], _peak_level_byte_max[l])) {
+				error << string_compose (_("could not truncate peakfile %1 to %2 (error: %3)"),
+							 peak_level_path (l), _peak_level_byte_max[l], errno) << endmsg;
+			}
+		}
+	}
+}
+
+string
+AudioSource::peak_level_path (uint32_t level) const
+{
+	assert (level < n_peak_levels);
+	return _peakpath + string_compose (".%1", peak_level_fpp[level]);
+}
+
+/** @return true if the given level exists, is not older than the
+ * peakfile and covers all peaks up to sample @param end
+ */
+bool
+AudioSource::peak_level_valid (uint32_t level, samplepos_t end) const
+{
+	GStatBuf level_stat;
+	GStatBuf peak_stat;
+
+	if (_peakpath.empty ()) {
+		return false;
+	}
+
+	if (g_stat (peak_level_path (level).c_str(), &level_stat) != 0 || g_stat (_peakpath.c_str(), &peak_stat) != 0) {
+		return false;
+	}
+
+	/* the peakfile was re-written by someone who does not know about
+	 * levels. Allow the same slop as initialize_peakfile() does.
+	 */
+	if (peak_stat.st_mtime > level_stat.st_mtime && (peak_stat.st_mtime - level_stat.st_mtime > 6)) {
+		return false;
+	}
+
+	const samplecnt_t fpp = peak_level_fpp[level];
+	return level_stat.st_size >= (off_t) (((end + fpp - 1) / fpp) * sizeof (PeakData));
+}
+
+int
+AudioSource::open_peak_levels ()
+{
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		if (-1 != _peak_level_fd[l]) {
+			continue;
+		}
+		_peak_level_acc_pos[l] = -1;
+		if ((_peak_level_fd[l] = g_open (peak_level_path (l).c_str(), O_CREAT|O_RDWR, 0664)) == -1) {
+			warning << string_compose(_("AudioSource: cannot open peak level file \"%1\" (%2)"), peak_level_path (l), strerror (errno)) << endmsg;
+			close_peak_levels ();
+			return -1;
+		}
+	}
+	return 0;
+}
+
+void
+AudioSource::close_peak_levels ()
+{
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		if (-1 != _peak_level_fd[l]) {
+			close (_peak_level_fd[l]);
+			_peak_level_fd[l] = -1;
+		}
+	}
+}
+
+void
+AudioSource::remove_peak_levels ()
+{
+	close_peak_levels ();
+
+	if (_peakpath.empty ()) {
+		return;
+	}
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		::g_unlink (peak_level_path (l).c_str());
+		_peak_level_byte_max[l] = 0;
+		_peak_level_acc_pos[l] = -1;
+	}
+}
+
+/** Reduce @a n_peaks peaks of the level below @a level, starting at
+ * @a first_peak, into @a level and all coarser ones. The level below
+ * level 0 is the peakfile itself.
+ *
+ * The peak of each level that is currently being filled is kept in
+ * memory, so nothing needs to be read back from disk. Peaks are expected
+ * to arrive in order; after a seek, the first peak of each level only
+ * covers the data written since.
+ *
+ * _lock MUST be held by caller.
+ */
+int
+AudioSource::update_peak_levels (uint32_t level, PeakData const* peaks, samplepos_t first_peak, samplecnt_t n_peaks)
+{
+	if (level >= n_peak_levels || n_peaks <= 0 || -1 == _peak_level_fd[level]) {
+		return 0;
+	}
+
+	const samplecnt_t ratio = peak_level_fpp[level] / (level == 0 ? _FPP : peak_level_fpp[level - 1]);
+	const samplecnt_t batch = 256;
+
+	PeakData    out[batch];
+	samplecnt_t n_out     = 0;
+	samplepos_t first_out = first_peak / ratio;
+
+	PeakData&    acc (_peak_level_acc[level]);
+	samplepos_t& acc_pos (_peak_level_acc_pos[level]);
+
+	for (samplecnt_t i = 0; i < n_peaks; ++i) {
+		const samplepos_t pos = (first_peak + i) / ratio;
+
+		if (pos != acc_pos) {
+			acc     = peaks[i];
+			acc_pos = pos;
+		} else {
+			acc.min = min (acc.min, peaks[i].min);
+			acc.max = max (acc.max, peaks[i].max);
+		}
+
+		if (n_out == 0 || pos != first_out + n_out - 1) {
+			if (n_out == batch) {
+				if (write_peak_level (level, out, first_out, n_out)) {
+					return -1;
+				}
+				first_out = pos;
+				n_out     = 0;
+			}
+			++n_out;
+		}
+
+		out[n_out - 1] = acc;
+	}
+
+	return write_peak_level (level, out, first_out, n_out);
+}
+
+/** Write @a n_peaks peaks of @a level starting at @a first_peak, and pass
+ * them on to the next coarser level.
+ * _lock MUST be held by caller.
+ */
+int
+AudioSource::write_peak_level (uint32_t level, PeakData const* peaks, samplepos_t first_peak, samplecnt_t n_peaks)
+{
+	const off_t   byte = first_peak * sizeof (PeakData);
+	const ssize_t bytes_to_write = n_peaks * sizeof (PeakData);
+
+	if (lseek (_peak_level_fd[level], byte, SEEK_SET) != byte || ::write (_peak_level_fd[level], peaks, bytes_to_write) != bytes_to_write) {
+		error << string_compose(_("%1: could not write peak file data (%2)"), _name, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	_peak_level_byte_max[level] = max (_peak_level_byte_max[level], (off_t) (byte + bytes_to_write));
+
+	return update_peak_levels (level + 1, peaks, first_peak, n_peaks);
+}
+
+bool
+AudioSource::peak_levels_missing () const
+{
+	if (empty () || !_build_peakfiles || (_flags & NoPeakFile)) {
+		return false;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+		if (!_peaks_built) {
+			return false;
+		}
+	}
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		if (!peak_level_valid (l, length().samples())) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** (re)create all levels from an existing peakfile */
+int
+AudioSource::build_peak_levels ()
+{
+	const samplecnt_t chunksize = 65536; // peaks per read, 512kB
+
+	WriterLock lp (_lock);
+
+	if (_session.deletion_in_progress() || _session.peaks_cleanup_in_progres() || 0 != (_flags & NoPeakFile)) {
+		return -1;
+	}
+
+	if (-1 != _peakfile_fd) {
+		/* peaks are being written, levels follow along */
+		return 0;
+	}
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building peak levels for %1\n", _peakpath));
+
+	remove_peak_levels ();
+
+	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+
+	if (sfd < 0) {
+		return -1;
+	}
+
+	int ret = open_peak_levels ();
+
+	const samplecnt_t n_peaks = _peak_byte_max / sizeof (PeakData);
+	boost::scoped_array<PeakData> buf (new PeakData[min (chunksize, n_peaks)]);
+
+	for (samplecnt_t p = 0; ret == 0 && p < n_peaks; p += chunksize) {
+		const samplecnt_t n = min (chunksize, n_peaks - p);
+		const ssize_t     bytes_to_read = n * sizeof (PeakData);
+
+		if (::read (sfd, buf.get(), bytes_to_read) != bytes_to_read) {
+			error << string_compose(_("%1: could not read peak file data (%2)"), _name, strerror (errno)) << endmsg;
+			ret = -1;
+			break;
+		}
+
+		ret = update_peak_levels (0, buf.get(), p, n);
+	}
+
+	if (ret) {
+		remove_peak_levels ();
+	} else {
+		close_peak_levels ();
+	}
+
+	return ret;
 }
 
 samplecnt_t
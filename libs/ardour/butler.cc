@@ -20,6 +20,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -54,6 +56,9 @@ Butler::Butler (Session& s)
 	: SessionHandleRef (s)
 	, thread ()
 	, have_thread (false)
+	, _disk_job_type (Refill)
+	, _helpers_start ("butler_helpers_start", 0)
+	, _helpers_done ("butler_helpers_done", 0)
 	, _audio_capture_buffer_size (0)
 	, _audio_playback_buffer_size (0)
 	, _midi_buffer_size (0)
@@ -61,6 +66,8 @@ Butler::Butler (Session& s)
 	, _xthread (true)
 {
 	should_do_transport_work.store (0);
+	_disk_job_index.store (0);
+	_helpers_quit.store (0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
 	/* catch future changes to parameters */
@@ -170,12 +177,136 @@ Butler::_thread_work (void* arg)
 	return ((Butler*)arg)->thread_work ();
 }
 
+void*
+Butler::_helper_thread_work (void* arg)
+{
+	SessionEvent::create_per_thread_pool ("butler helper events", 64);
+	pthread_set_name (X_("butler helper"));
+	return ((Butler*)arg)->helper_thread_work ();
+}
+
+void
+Butler::start_helpers (uint32_t n_helpers)
+{
+	assert (_helpers.empty ());
+
+	_helpers_quit.store (0);
+
+	for (uint32_t i = 0; i < n_helpers; ++i) {
+		pthread_t t;
+		if (pthread_create_and_store (string_compose ("disk butler %1", i + 1), &t, _helper_thread_work, this)) {
+			error << _("Session: could not create butler helper thread") << endmsg;
+			break;
+		}
+		_helpers.push_back (t);
+	}
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler uses %1 helper threads\n", _helpers.size ()));
+}
+
+void
+Butler::stop_helpers ()
+{
+	if (_helpers.empty ()) {
+		return;
+	}
+
+	_helpers_quit.store (1);
+
+	for (size_t i = 0; i < _helpers.size (); ++i) {
+		_helpers_start.signal ();
+	}
+
+	for (auto const& t : _helpers) {
+		void* status;
+		pthread_join (t, &status);
+	}
+
+	_helpers.clear ();
+	_helpers_start.reset ();
+	_helpers_done.reset ();
+}
+
+void*
+Butler::helper_thread_work ()
+{
+	DiskReader::allocate_thread_working_buffers ();
+
+	while (true) {
+		_helpers_start.wait ();
+
+		if (_helpers_quit.load ()) {
+			break;
+		}
+
+		Temporal::TempoMap::fetch ();
+		process_disk_jobs ();
+
+		_helpers_done.signal ();
+	}
+
+	DiskReader::free_thread_working_buffers ();
+	return 0;
+}
+
+/** Process all queued _disk_jobs, using the butler thread and all helpers */
+void
+Butler::run_disk_jobs (DiskJobType type)
+{
+	if (_disk_jobs.empty ()) {
+		return;
+	}
+
+	_disk_job_type = type;
+	_disk_job_index.store (0);
+
+	/* no need to wake up more threads than there are jobs */
+	size_t n_helpers = std::min (_helpers.size (), _disk_jobs.size () - 1);
+
+	for (size_t i = 0; i < n_helpers; ++i) {
+		_helpers_start.signal ();
+	}
+
+	process_disk_jobs ();
+
+	for (size_t i = 0; i < n_helpers; ++i) {
+		_helpers_done.wait ();
+	}
+}
+
+void
+Butler::process_disk_jobs ()
+{
+	while (true) {
+		size_t n = _disk_job_index.fetch_add (1);
+
+		if (n >= _disk_jobs.size ()) {
+			break;
+		}
+
+		DiskJob& job (_disk_jobs[n]);
+
+		if (transport_work_requested () || !should_run) {
+			/* we didn't get to this track, try again later */
+			job.retval = 1;
+			continue;
+		}
+
+		switch (_disk_job_type) {
+			case Refill:
+				job.retval = job.track->do_refill ();
+				break;
+			case Flush:
+				job.retval = job.track->do_flush (ButlerContext, false);
+				break;
+		}
+	}
+}
+
 void*
 Butler::thread_work ()
 {
-	uint32_t            err                   = 0;
-	bool                disk_work_outstanding = false;
-	RouteList::iterator i;
+	uint32_t err                   = 0;
+	bool     disk_work_outstanding = false;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time ()));
@@ -200,6 +331,7 @@ Butler::thread_work ()
 
 					case Request::Quit:
 						DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: butler asked to quit @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time ()));
+						stop_helpers ();
 						return 0;
 						abort (); /*NOTREACHED*/
 						break;
@@ -212,6 +344,15 @@ Butler::thread_work ()
 
 		Temporal::TempoMap::fetch ();
 
+		/* (re)start helper threads if the configuration changed.
+		 * This is the only place where no disk jobs are in progress.
+		 */
+		uint32_t n_threads = std::max<uint32_t> (1, std::min<uint32_t> (32, Config->get_butler_threads ()));
+		if (_helpers.size () + 1 != n_threads) {
+			stop_helpers ();
+			start_helpers (n_threads - 1);
+		}
+
 	restart:
 		std::atomic_thread_fence (std::memory_order_acquire);
 
@@ -253,41 +394,8 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested ()));
 
-		for (i = rl_with_auditioner.begin (); !transport_work_requested () && should_run && i != rl_with_auditioner.end (); ++i) {
-			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			std::shared_ptr<IO> io = tr->input ();
-
-			if (io && !io->active ()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-				case 0:
-					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-					break;
-
-				case 1:
-					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
-					disk_work_outstanding = true;
-					break;
-
-				default:
-					error << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << endmsg;
-					std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << std::endl;
-					break;
-			}
-		}
-
-		if (i != rl_with_auditioner.begin () && i != rl_with_auditioner.end ()) {
-			/* we didn't get to all the streams */
-			disk_work_outstanding = true;
+		if (!transport_work_requested () && should_run) {
+			disk_work_outstanding = refill_tracks (rl_with_auditioner);
 		}
 
 		if (!err && transport_work_requested ()) {
@@ -335,15 +443,70 @@ Butler::thread_work ()
 	return (0);
 }
 
+bool
+Butler::refill_tracks (RouteList const& rl)
+{
+	bool disk_work_outstanding = false;
+
+	_disk_jobs.clear ();
+
+	for (auto const& r : rl) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+
+		if (!tr) {
+			continue;
+		}
+
+		std::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active ()) {
+			/* don't read inactive tracks */
+			continue;
+		}
+
+		_disk_jobs.push_back (DiskJob (tr, tr->playback_buffer_load ()));
+	}
+
+	/* refill tracks that are closest to an underrun first */
+	std::stable_sort (_disk_jobs.begin (), _disk_jobs.end (), [] (DiskJob const& a, DiskJob const& b) { return a.buffer_load < b.buffer_load; });
+
+	run_disk_jobs (Refill);
+
+	for (auto const& job : _disk_jobs) {
+		switch (job.retval) {
+			case 0:
+				break;
+
+			case 1:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", job.track->name ()));
+				disk_work_outstanding = true;
+				break;
+
+			default:
+				error << string_compose (_("Butler read ahead failure on dstream %1"), job.track->name ()) << endmsg;
+				std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), job.track->name ()) << std::endl;
+				break;
+		}
+	}
+
+	_disk_jobs.clear ();
+
+	return disk_work_outstanding;
+}
+
 bool
 Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32_t& errors)
 {
 	bool disk_work_outstanding = false;
 
-	for (RouteList::const_iterator i = rl->begin (); !transport_work_requested () && should_run && i != rl->end (); ++i) {
-		// cerr << "write behind for " << (*i)->name () << endl;
+	if (transport_work_requested () || !should_run) {
+		return false;
+	}
+
+	_disk_jobs.clear ();
 
-		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
+	for (auto const& r : *rl) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
 
 		if (!tr) {
 			continue;
@@ -351,31 +514,35 @@ Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32
 
 		/* note that we still try to flush diskstreams attached to inactive routes
 		 */
+		_disk_jobs.push_back (DiskJob (tr, tr->capture_buffer_load ()));
+	}
 
-		int ret;
+	/* flush tracks that are closest to an overrun first */
+	std::stable_sort (_disk_jobs.begin (), _disk_jobs.end (), [] (DiskJob const& a, DiskJob const& b) { return a.buffer_load > b.buffer_load; });
 
-		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
-		ret = tr->do_flush (ButlerContext, false);
-		switch (ret) {
+	run_disk_jobs (Flush);
+
+	for (auto const& job : _disk_jobs) {
+		switch (job.retval) {
 			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
 				break;
 
 			case 1:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
 				disk_work_outstanding = true;
 				break;
 
 			default:
 				errors++;
-				error << string_compose (_("Butler write-behind failure on dstream %1"), (*i)->name ()) << endmsg;
-				std::cerr << string_compose (_("Butler write-behind failure on dstream %1"), (*i)->name ()) << std::endl;
+				error << string_compose (_("Butler write-behind failure on dstream %1"), job.track->name ()) << endmsg;
+				std::cerr << string_compose (_("Butler write-behind failure on dstream %1"), job.track->name ()) << std::endl;
 				/* don't break - try to flush all streams in case they
-			   are split across disks.
-			*/
+				 * are split across disks.
+				 */
 		}
 	}
 
+	_disk_jobs.clear ();
+
 	return disk_work_outstanding;
 }
 
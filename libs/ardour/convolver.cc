@@ -19,6 +19,7 @@
 #include <assert.h>
 
 #include "pbd/error.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
 
 #include "ardour/audio_buffer.h"
@@ -45,7 +46,11 @@ Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     , _max_size (0)
     , _offset (0)
     , _configured (false)
-    , _threaded (false)
+    , _latency_mode (Unthreaded)
+    , _proc_usec (0)
+    , _proc_samples (0)
+    , _late_cycles (0)
+    , _sample_rate (session.nominal_sample_rate ())
     , _n_inputs (n_in)
     , _n_outputs (n_out)
 {
@@ -86,6 +91,36 @@ Convolution::ready () const
 	return _configured && _convproc.state () == Convproc::ST_PROC;
 }
 
+void
+Convolution::set_latency_mode (LatencyMode m)
+{
+	if (_latency_mode == m) {
+		return;
+	}
+	_latency_mode = m;
+	restart ();
+}
+
+float
+Convolution::dsp_load () const
+{
+	if (_proc_samples == 0 || _sample_rate == 0) {
+		return 0;
+	}
+	return _proc_usec * 1e-6 * _sample_rate / _proc_samples;
+}
+
+void
+Convolution::process ()
+{
+	PBD::microseconds_t const start = PBD::get_microseconds ();
+	if (_convproc.process () & Convproc::FL_LATE) {
+		++_late_cycles;
+	}
+	_proc_usec    += PBD::get_microseconds () - start;
+	_proc_samples += _n_samples;
+}
+
 void
 Convolution::restart ()
 {
@@ -98,21 +133,38 @@ Convolution::restart ()
 		return;
 	}
 
-	uint32_t n_part;
-
-	if (_threaded) {
-		_n_samples = 64;
-		n_part     = Convproc::MAXPART;
-	} else {
-		_n_samples = _session.get_block_size ();
-		uint32_t power_of_two;
-		for (power_of_two = 1; 1U << power_of_two < _n_samples; ++power_of_two) ;
-		_n_samples = 1 << power_of_two;
-		n_part     = std::min ((uint32_t)Convproc::MAXPART, _n_samples);
+	uint32_t n_part = Convproc::MAXPART;
+
+	/* The head partition (quantum == min-partition) is processed by
+	 * the calling thread, all larger partitions by background threads.
+	 */
+	switch (_latency_mode) {
+		case LowLatency:
+			_n_samples = 64;
+			break;
+		case Balanced:
+			_n_samples = 256;
+			break;
+		case LowCPU:
+			_n_samples = 1024;
+			break;
+		case Unthreaded:
+			{
+				_n_samples = _session.get_block_size ();
+				uint32_t power_of_two;
+				for (power_of_two = 1; 1U << power_of_two < _n_samples; ++power_of_two) ;
+				_n_samples = 1 << power_of_two;
+				n_part     = std::min ((uint32_t)Convproc::MAXPART, _n_samples);
+			}
+			break;
 	}
 
-	_offset    = 0;
-	_max_size  = 0;
+	_offset       = 0;
+	_max_size     = 0;
+	_proc_usec    = 0;
+	_proc_samples = 0;
+	_late_cycles  = 0;
+	_sample_rate  = _session.nominal_sample_rate ();
 
 	for (std::vector<ImpData>::const_iterator i = _impdata.begin (); i != _impdata.end (); ++i) {
 		_max_size = std::max (_max_size, (uint32_t)i->readable_length_samples ());
@@ -227,7 +279,7 @@ Convolution::run (BufferSet& bufs, ChanMapping const& in_map, ChanMapping const&
 		remain  -= ns;
 
 		if (_offset == _n_samples) {
-			_convproc.process ();
+			process ();
 			_offset = 0;
 		}
 	}
@@ -244,7 +296,7 @@ Convolver::Convolver (
     , _irc (irc)
     , _ir_settings (irs)
 {
-	_threaded = true;
+	_latency_mode = LowLatency;
 
 	std::vector<std::shared_ptr<AudioReadable> > readables = AudioReadable::load (_session, path);
 
@@ -353,7 +405,7 @@ Convolution::run_mono_buffered (float* buf, uint32_t n_samples)
 		remain  -= ns;
 
 		if (_offset == _n_samples) {
-			_convproc.process ();
+			process ();
 			_offset = 0;
 		}
 	}
@@ -383,7 +435,7 @@ Convolver::run_stereo_buffered (float* left, float* right, uint32_t n_samples)
 		remain  -= ns;
 
 		if (_offset == _n_samples) {
-			_convproc.process ();
+			process ();
 			_offset = 0;
 		}
 	}
@@ -413,7 +465,7 @@ Convolution::run_mono_no_latency (float* buf, uint32_t n_samples)
 		memcpy (&in[_offset], &buf[done], sizeof (float) * ns);
 
 		if (_offset + ns == _n_samples) {
-			_convproc.process ();
+			process ();
 			memcpy (&buf[done], &out[_offset], sizeof (float) * ns);
 			_offset = 0;
 		} else {
@@ -448,7 +500,7 @@ Convolver::run_stereo_no_latency (float* left, float* right, uint32_t n_samples)
 		}
 
 		if (_offset + ns == _n_samples) {
-			_convproc.process ();
+			process ();
 			memcpy (&left[done],  &outL[_offset], sizeof (float) * ns);
 			memcpy (&right[done], &outR[_offset], sizeof (float) * ns);
 			_offset = 0;
@@ -27,6 +27,7 @@
 
 using namespace std;
 
+PBD::DebugBits PBD::DEBUG::Analysis = PBD::new_debug_bit ("analysis");
 PBD::DebugBits PBD::DEBUG::AudioEngine = PBD::new_debug_bit ("AudioEngine");
 PBD::DebugBits PBD::DEBUG::AudioPlayback = PBD::new_debug_bit ("audioplayback");
 PBD::DebugBits PBD::DEBUG::AudioUnitConfig = PBD::new_debug_bit ("AudioUnitConfig");
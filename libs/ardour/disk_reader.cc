@@ -19,6 +19,8 @@
 
 #include <boost/smart_ptr/scoped_array.hpp>
 
+#include <glibmm/threads.h>
+
 #include "pbd/enumwriter.h"
 #include "pbd/memento_command.h"
 #include "pbd/playback_buffer.h"
@@ -57,6 +59,35 @@ DiskReader::Declicker DiskReader::loop_declick_in;
 DiskReader::Declicker DiskReader::loop_declick_out;
 samplecnt_t           DiskReader::loop_fade_length (0);
 
+namespace {
+struct WorkingBuffers {
+	WorkingBuffers ()
+		: sum_buffer (new Sample[2 * 1048576])
+		, mixdown_buffer (new Sample[2 * 1048576])
+		, gain_buffer (new gain_t[2 * 1048576])
+	{}
+
+	~WorkingBuffers ()
+	{
+		delete[] sum_buffer;
+		delete[] mixdown_buffer;
+		delete[] gain_buffer;
+	}
+
+	Sample* sum_buffer;
+	Sample* mixdown_buffer;
+	gain_t* gain_buffer;
+};
+
+static void
+release_working_buffers (WorkingBuffers* wb)
+{
+	delete wb;
+}
+
+static Glib::Threads::Private<WorkingBuffers> thread_working_buffers (release_working_buffers);
+}
+
 DiskReader::DiskReader (Session& s, Track& t, string const& str, Temporal::TimeDomainProvider const & tdp, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("player:") + str, f, tdp)
 	, overwrite_sample (0)
@@ -148,6 +179,20 @@ DiskReader::free_working_buffers ()
 	_gain_buffer    = 0;
 }
 
+void
+DiskReader::allocate_thread_working_buffers ()
+{
+	if (!thread_working_buffers.get ()) {
+		thread_working_buffers.set (new WorkingBuffers);
+	}
+}
+
+void
+DiskReader::free_thread_working_buffers ()
+{
+	thread_working_buffers.replace (0);
+}
+
 samplecnt_t
 DiskReader::default_chunk_samples ()
 {
@@ -1101,6 +1146,10 @@ int
 DiskReader::do_refill ()
 {
 	const bool reversed = !_session.transport_will_roll_forwards ();
+	WorkingBuffers* wb  = thread_working_buffers.get ();
+	if (wb) {
+		return refill (wb->sum_buffer, wb->mixdown_buffer, wb->gain_buffer, 0, reversed);
+	}
 	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
 }
 
@@ -1592,8 +1641,10 @@ DiskReader::dec_no_disk_output ()
 
 DiskReader::DeclickAmp::DeclickAmp (samplecnt_t sample_rate)
 {
-	_a = 800.f / (gain_t)sample_rate; // ~ 1/50Hz to fade by 40dB
-	_l = -log1p (_a);
+	/* ~ 1/50Hz to fade by 40dB, when stepping the gain every 4 samples,
+	 * converted to the equivalent per-sample coefficient: (1 - a)^4 = 1 - 800 / SR
+	 */
+	_a = 1.f - powf (1.f - 800.f / (gain_t)sample_rate, .25f);
 	_g = 0;
 }
 
@@ -1611,30 +1662,7 @@ DiskReader::DeclickAmp::apply_gain (AudioBuffer& buf, samplecnt_t n_samples, con
 		return;
 	}
 
-	const float   a      = _a;
-	Sample* const buffer = buf.data ();
-
-	const int max_nproc = 4;
-	uint32_t  remain    = n_samples;
-	uint32_t  offset    = buffer_offset;
-
-	while (remain > 0) {
-		uint32_t n_proc = remain > max_nproc ? max_nproc : remain;
-		for (uint32_t i = 0; i < n_proc; ++i) {
-			buffer[offset + i] *= g;
-		}
-#if 1
-		g += a * (target - g);
-#else /* accurate exponential fade */
-		if (n_proc == max_nproc) {
-			g += a * (target - g);
-		} else {
-			g = target - (target - g) * expf (_l * n_proc / max_nproc);
-		}
-#endif
-		remain -= n_proc;
-		offset += n_proc;
-	}
+	g = apply_gain_ramp (buf.data (buffer_offset), n_samples, g, target, _a);
 
 	if (fabsf (g - target) < GAIN_COEFF_DELTA) {
 		_g = target;
@@ -1802,12 +1830,7 @@ DiskReader::Declicker::run (Sample* buf, samplepos_t read_start, samplepos_t rea
 			return;
 	}
 
-	Sample* b = &buf[bo];
-	gain_t* g = &vec[vo];
-
-	for (sampleoffset_t i = 0; i < n; ++i) {
-		b[i] *= g[i];
-	}
+	apply_gain_vector_to_buffer (&buf[bo], &vec[vo], n);
 }
 
 void
@@ -38,6 +38,9 @@
 #include "ardour/smf_source.h"
 
 #include "pbd/atomic.h"
+#include "pbd/cpus.h"
+#include "pbd/mpmc_queue.h"
+#include "pbd/pthread_utils.h"
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -47,6 +50,189 @@ using namespace std;
 ARDOUR::samplecnt_t DiskWriter::_chunk_samples = DiskWriter::default_chunk_samples ();
 PBD::Signal0<void> DiskWriter::Overrun;
 
+namespace ARDOUR {
+
+/** Threads that write captured audio to disk on behalf of the butler.
+ *
+ * DiskWriter::do_flush() submits the pending chunk of every channel as
+ * one batch, processes jobs of the batch itself and waits until all of
+ * them are written. Batches of different tracks can be in flight at the
+ * same time when the butler uses helper threads.
+ */
+class WriteBehindPool
+{
+public:
+	struct Batch {
+		Batch (size_t n) : remaining (n) {}
+		Glib::Threads::Mutex lock;
+		Glib::Threads::Cond  cond;
+		size_t               remaining;
+	};
+
+	struct Job {
+		Job (AudioFileSource* s, Sample* b0, samplecnt_t l0, Sample* b1, samplecnt_t l1)
+			: source (s)
+			, written (0)
+			, batch (0)
+		{
+			buf[0] = b0;
+			buf[1] = b1;
+			len[0] = l0;
+			len[1] = l1;
+		}
+
+		void run ();
+
+		AudioFileSource* source;
+		Sample*          buf[2];
+		samplecnt_t      len[2];
+		samplecnt_t      written;
+		Batch*           batch;
+	};
+
+	static void attach ();
+	static void detach ();
+
+	static void process (std::vector<Job>&);
+
+private:
+	WriteBehindPool (uint32_t n_threads);
+	~WriteBehindPool ();
+
+	void run ();
+
+	PBD::MPMCQueue<Job*>      _queue;
+	PBD::Semaphore            _sem;
+	std::vector<PBD::Thread*> _threads;
+	std::atomic<bool>         _exit;
+
+	static WriteBehindPool*     _instance;
+	static uint32_t             _users;
+	static Glib::Threads::Mutex _instance_lock;
+};
+
+WriteBehindPool*     WriteBehindPool::_instance = 0;
+uint32_t             WriteBehindPool::_users    = 0;
+Glib::Threads::Mutex WriteBehindPool::_instance_lock;
+
+WriteBehindPool::WriteBehindPool (uint32_t n_threads)
+	: _queue (1024)
+	, _sem ("write_behind", 0)
+{
+	_exit.store (false);
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&WriteBehindPool::run, this));
+		if (t) {
+			_threads.push_back (t);
+		}
+	}
+	/* without threads, process() writes all jobs itself */
+}
+
+WriteBehindPool::~WriteBehindPool ()
+{
+	_exit.store (true);
+	for (size_t i = 0; i < _threads.size (); ++i) {
+		_sem.signal ();
+	}
+	for (std::vector<PBD::Thread*>::iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+		delete *i;
+	}
+}
+
+void
+WriteBehindPool::attach ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (_users++ == 0) {
+		_instance = new WriteBehindPool (std::max<uint32_t> (1, std::min<uint32_t> (4, hardware_concurrency () - 1)));
+	}
+}
+
+void
+WriteBehindPool::detach ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	assert (_users > 0);
+	if (--_users == 0) {
+		delete _instance;
+		_instance = 0;
+	}
+}
+
+void
+WriteBehindPool::Job::run ()
+{
+	for (int i = 0; i < 2; ++i) {
+		if (len[i] == 0) {
+			continue;
+		}
+		if (source->write (buf[i], len[i]) != len[i]) {
+			break;
+		}
+		written += len[i];
+	}
+
+	Glib::Threads::Mutex::Lock lm (batch->lock);
+	if (--batch->remaining == 0) {
+		batch->cond.signal ();
+	}
+}
+
+void
+WriteBehindPool::process (std::vector<Job>& jobs)
+{
+	Batch batch (jobs.size ());
+
+	for (auto& j : jobs) {
+		j.batch = &batch;
+	}
+
+	/* The first job is written by the calling thread, which also
+	 * takes care of jobs that cannot be queued.
+	 */
+	for (size_t i = 1; i < jobs.size (); ++i) {
+		if (_instance && !_instance->_threads.empty () && _instance->_queue.push_back (&jobs[i])) {
+			_instance->_sem.signal ();
+		} else {
+			jobs[i].run ();
+		}
+	}
+
+	jobs[0].run ();
+
+	/* help with any jobs that were not yet picked up */
+	Job* j;
+	while (_instance && _instance->_queue.pop_front (j)) {
+		j->run ();
+	}
+
+	Glib::Threads::Mutex::Lock lm (batch.lock);
+	while (batch.remaining > 0) {
+		batch.cond.wait (batch.lock);
+	}
+}
+
+void
+WriteBehindPool::run ()
+{
+	pthread_set_name ("WriteBehind");
+
+	while (true) {
+		_sem.wait ();
+		if (_exit.load ()) {
+			break;
+		}
+		Job* j;
+		if (_queue.pop_front (j)) {
+			j->run ();
+		}
+	}
+}
+
+} // namespace ARDOUR
+
 DiskWriter::DiskWriter (Session& s, Track& t, string const & str, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("recorder:") + str, f, Temporal::TimeDomainProvider (Config->get_default_automation_time_domain()))
 	, _capture_captured (0)
@@ -69,6 +255,8 @@ DiskWriter::DiskWriter (Session& s, Track& t, string const & str, DiskIOProcesso
 	_record_safe.store (0);
 	_samples_pending_write.store (0);
 	_num_captured_loops.store (0);
+
+	WriteBehindPool::attach ();
 }
 
 DiskWriter::~DiskWriter ()
@@ -80,6 +268,8 @@ DiskWriter::~DiskWriter ()
 	for (auto const& chaninfo : *c) {
 		chaninfo->write_source.reset ();
 	}
+
+	WriteBehindPool::detach ();
 }
 
 samplecnt_t
@@ -900,8 +1090,12 @@ DiskWriter::buffer_load () const
 		return 1.0;
 	}
 
-	return (float) ((double) c->front()->wbuf->write_space()/
-			(double) c->front()->wbuf->bufsize());
+	/* the channel closest to an overrun */
+	float load = 1.0;
+	for (auto const& chan : *c) {
+		load = std::min (load, (float) ((double) chan->wbuf->write_space() / (double) chan->wbuf->bufsize()));
+	}
+	return load;
 }
 
 void
@@ -955,11 +1149,16 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 	int32_t ret = 0;
 	RingBufferNPT<Sample>::rw_vector vector;
 	samplecnt_t total;
+	bool skip = false;
 
 	vector.buf[0] = 0;
 	vector.buf[1] = 0;
 
 	std::shared_ptr<ChannelList const> c = channels.reader();
+
+	std::vector<WriteBehindPool::Job> jobs;
+	jobs.reserve (c->size ());
+
 	for (auto const& chan : *c) {
 
 		chan->wbuf->get_read_vector (&vector);
@@ -967,7 +1166,8 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 		total = vector.len[0] + vector.len[1];
 
 		if (total == 0 || (total < _chunk_samples && !force_flush && _was_recording)) {
-			goto out;
+			skip = true;
+			break;
 		}
 
 		/* if there are 2+ chunks of disk i/o possible for
@@ -985,35 +1185,66 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 			ret = 1;
 		}
 
-		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
-
-		if ((!chan->write_source) || chan->write_source->write (vector.buf[0], to_write) != to_write) {
+		if (!chan->write_source) {
 			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 			return -1;
 		}
 
-		chan->wbuf->increment_read_ptr (to_write);
-		chan->curr_capture_cnt += to_write;
+		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
+
+		samplecnt_t to_write_1 = 0;
 
 		if ((to_write == vector.len[0]) && (total > to_write) && (to_write < _chunk_samples)) {
 
-			/* we wrote all of vector.len[0] but it wasn't an entire
+			/* we write all of vector.len[0] but it isn't an entire
 			   disk_write_chunk_samples of data, so arrange for some part
 			   of vector.len[1] to be flushed to disk as well.
 			*/
 
-			to_write = min ((samplecnt_t)(_chunk_samples - to_write), (samplecnt_t) vector.len[1]);
+			to_write_1 = min ((samplecnt_t)(_chunk_samples - to_write), (samplecnt_t) vector.len[1]);
 
-                        DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write));
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write_1));
+		}
 
-			if (chan->write_source->write (vector.buf[1], to_write) != to_write) {
-				error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
-				return -1;
+		jobs.push_back (WriteBehindPool::Job (chan->write_source.get (), vector.buf[0], to_write, vector.buf[1], to_write_1));
+	}
+
+	/* write all channels in parallel. The ring-buffer data remains
+	 * valid until the read-pointer is advanced, so it is written
+	 * in-place without copying it.
+	 */
+
+	if (!jobs.empty ()) {
+#ifndef NDEBUG
+		int64_t const start = g_get_monotonic_time ();
+#endif
+
+		WriteBehindPool::process (jobs);
+
+		bool   failed = false;
+		size_t n      = 0;
+
+		for (auto const& chan : *c) {
+			if (n == jobs.size ()) {
+				break;
 			}
+			WriteBehindPool::Job const& job (jobs[n++]);
+			chan->wbuf->increment_read_ptr (job.written);
+			chan->curr_capture_cnt += job.written;
+			failed |= job.written != job.len[0] + job.len[1];
+		}
 
-			chan->wbuf->increment_read_ptr (to_write);
-			chan->curr_capture_cnt += to_write;
+		if (failed) {
+			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
+			return -1;
 		}
+
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 wrote %2 channels in %3 usec, capture buffer load %4\n",
+		                                            name(), jobs.size (), g_get_monotonic_time () - start, buffer_load ()));
+	}
+
+	if (skip) {
+		goto out;
 	}
 
 	/* MIDI*/
@@ -51,9 +51,7 @@ ARDOUR::DSP::memset (float* data, const float val, const uint32_t n_samples)
 void
 ARDOUR::DSP::mmult (float* data, float* mult, const uint32_t n_samples)
 {
-	for (uint32_t i = 0; i < n_samples; ++i) {
-		data[i] *= mult[i];
-	}
+	ARDOUR::apply_gain_vector_to_buffer (data, mult, n_samples);
 }
 
 float
@@ -145,6 +145,7 @@ setup_enum_writer ()
 	WaveformScale _WaveformScale;
 	WaveformShape _WaveformShape;
 	ScreenSaverMode _ScreenSaverMode;
+	ProcessGraphScheduler _ProcessGraphScheduler;
 	PluginGUIBehavior _PluginGUIBehavior;
 	AppleNSGLViewMode _AppleNSGLViewMode;
 	Session::PostTransportWork _Session_PostTransportWork;
@@ -784,6 +785,10 @@ setup_enum_writer ()
 	REGISTER_ENUM(InhibitAlways);
 	REGISTER(_ScreenSaverMode);
 
+	REGISTER_ENUM(SharedQueueScheduler);
+	REGISTER_ENUM(WorkStealingScheduler);
+	REGISTER(_ProcessGraphScheduler);
+
 	REGISTER_ENUM(PluginGUIHide);
 	REGISTER_ENUM(PluginGUIDestroyAny);
 	REGISTER_ENUM(PluginGUIDestroyVST);
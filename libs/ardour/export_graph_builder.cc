@@ -108,14 +108,15 @@ using std::string;
  *      /-----------+-------------------------------------\
  *      |                                                 |
  *      v                                                 |
- * {   Intermediate (normalize or realtime)               |
+ * {   Intermediate (normalize, realtime or parallel)     |
  * |    |                                                 |
  * |    \---+------or-------+-------or-------\            |
  * |        v               v                v            |
  * |     Peak Reader -> Loudness Reader -> TMP File       |
  * |                                         |            |
  * |                                         v            |
- * |               Threader (run SFC childs in parallel)  |
+ * |     post_process (run SFC childs of all |            |
+ * |     Intermediates in parallel)          |            |
  * }                                         |            |
  *                                           v            |
  *      /------------------------------------/            |
@@ -157,6 +158,10 @@ namespace ARDOUR {
 
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
+	, branches_pending (0)
+	, _realtime (false)
+	, _parallel (false)
+	, _master_align (0)
 	, thread_pool (hardware_concurrency())
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
@@ -206,6 +211,8 @@ ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
 bool
 ExportGraphBuilder::post_process ()
 {
+	/* read the next chunk of every Intermediate, this queues a branch
+	 * for each SFC child ... */
 	for (std::list<Intermediate *>::iterator it = intermediates.begin(); it != intermediates.end(); /* ++ in loop */) {
 		if ((*it)->process()) {
 			it = intermediates.erase (it);
@@ -214,9 +221,72 @@ ExportGraphBuilder::post_process ()
 		}
 	}
 
+	/* ... and process all of them concurrently */
+	run_branches ();
+
 	return intermediates.empty();
 }
 
+void
+ExportGraphBuilder::queue_branch (FloatSinkPtr sink, ProcessContext<Sample> const& c)
+{
+	branches.push_back (Branch (sink, c));
+}
+
+void
+ExportGraphBuilder::run_branches ()
+{
+	if (branches.empty ()) {
+		return;
+	}
+
+	branch_exception.reset ();
+	branches_pending = branches.size () - 1;
+
+	for (size_t i = 1; i < branches.size (); ++i) {
+		thread_pool.push (sigc::bind (sigc::mem_fun (this, &ExportGraphBuilder::process_branch), i));
+	}
+
+	/* the calling thread processes the first branch itself */
+	run_branch (0);
+
+	Glib::Threads::Mutex::Lock lm (branch_lock);
+	while (branches_pending > 0) {
+		branch_cond.wait (branch_lock);
+	}
+
+	branches.clear ();
+
+	if (branch_exception) {
+		throw *branch_exception;
+	}
+}
+
+void
+ExportGraphBuilder::run_branch (size_t n)
+{
+	try {
+		branches[n].sink->process (branches[n].context);
+	} catch (std::exception const& e) {
+		/* Only first exception will be passed on */
+		Glib::Threads::Mutex::Lock lm (branch_lock);
+		if (!branch_exception) {
+			branch_exception.reset (new ThreaderException (*this, e));
+		}
+	}
+}
+
+void
+ExportGraphBuilder::process_branch (size_t n)
+{
+	run_branch (n);
+
+	Glib::Threads::Mutex::Lock lm (branch_lock);
+	if (--branches_pending == 0) {
+		branch_cond.signal ();
+	}
+}
+
 unsigned
 ExportGraphBuilder::get_postprocessing_cycle_count() const
 {
@@ -234,9 +304,12 @@ ExportGraphBuilder::reset ()
 	channel_configs.clear ();
 	channels.clear ();
 	intermediates.clear ();
+	postprocessed.clear ();
+	branches.clear ();
 	analysis_map.clear();
 	_exported_files.clear();
 	_realtime = false;
+	_parallel = false;
 	_master_align = 0;
 }
 
@@ -245,6 +318,9 @@ ExportGraphBuilder::cleanup (bool remove_out_files/*=false*/)
 {
 	ChannelConfigList::iterator iter = channel_configs.begin();
 
+	intermediates.clear ();
+	postprocessed.clear ();
+
 	while (iter != channel_configs.end() ) {
 		iter->remove_children(remove_out_files);
 		iter = channel_configs.erase(iter);
@@ -275,6 +351,7 @@ ExportGraphBuilder::add_config (FileSpec const & config, bool rt)
 	}
 
 	_realtime = rt;
+	_parallel = Config->get_export_parallel_encoding ();
 
 	if (!timespan->vapor().empty()) {
 		/* plugin export needs no actual channels */
@@ -326,6 +403,14 @@ ExportGraphBuilder::get_analysis_results (AnalysisResults& results) {
 	}
 }
 
+void
+ExportGraphBuilder::get_postprocessing_progress (std::map<std::string, float>& progress) const
+{
+	for (std::list<Intermediate *>::const_iterator it = postprocessed.begin(); it != postprocessed.end(); ++it) {
+		(*it)->get_progress (progress);
+	}
+}
+
 void
 ExportGraphBuilder::add_split_config (FileSpec const & config)
 {
@@ -691,6 +776,12 @@ ExportGraphBuilder::SFC::set_peak_lufs (AudioGrapher::LoudnessReader const& lr)
 	}
 }
 
+std::string
+ExportGraphBuilder::SFC::name () const
+{
+	return Glib::path_get_basename (config.filename->get_path (config.format));
+}
+
 ExportGraphBuilder::FloatSinkPtr
 ExportGraphBuilder::SFC::sink ()
 {
@@ -776,6 +867,7 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 	: parent (parent)
 	, use_loudness (false)
 	, use_peak (false)
+	, samples_read (0)
 {
 	std::string tmpfile_path = parent.session.session_directory().export_path();
 	tmpfile_path = Glib::build_filename(tmpfile_path, "XXXXXX");
@@ -791,7 +883,6 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 
 	peak_reader.reset (new PeakReader ());
 	loudness_reader.reset (new LoudnessReader (config.format->sample_rate(), channels, max_samples));
-	threader.reset (new Threader<Sample> (parent.thread_pool));
 
 	int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
 
@@ -838,7 +929,6 @@ ExportGraphBuilder::Intermediate::add_child (FileSpec const & new_config)
 	}
 
 	children.push_back (new SFC (parent, new_config, max_samples_out));
-	threader->add_output (children.back().sink());
 }
 
 void
@@ -865,11 +955,33 @@ ExportGraphBuilder::Intermediate::get_postprocessing_cycle_count() const
 	                                       max_samples_out));
 }
 
+void
+ExportGraphBuilder::Intermediate::get_progress (std::map<std::string, float>& progress) const
+{
+	samplecnt_t const total = tmp_file->get_samples_written ();
+	float const p = total > 0 ? std::min (1.f, samples_read / (float) total) : 1.f;
+	for (boost::ptr_list<SFC>::const_iterator i = children.begin(); i != children.end(); ++i) {
+		progress[i->name ()] = p;
+	}
+}
+
 bool
 ExportGraphBuilder::Intermediate::process()
 {
-	samplecnt_t samples_read = tmp_file->read (*buffer);
-	return samples_read != buffer->samples();
+	/* tmp_file has no outputs, the chunk is only read into the buffer */
+	samplecnt_t const n = tmp_file->read (*buffer);
+	samples_read += n;
+
+	ProcessContext<Sample> c (buffer->beginning (n));
+	if (n != buffer->samples()) {
+		c.set_flag (ProcessContext<Sample>::EndOfInput);
+	}
+
+	for (boost::ptr_list<SFC>::iterator i = children.begin(); i != children.end(); ++i) {
+		parent.queue_branch (i->sink (), c);
+	}
+
+	return n != buffer->samples();
 }
 
 void
@@ -884,8 +996,8 @@ ExportGraphBuilder::Intermediate::prepare_post_processing()
 		}
 	}
 
-	tmp_file->add_output (threader);
 	parent.intermediates.push_back (this);
+	parent.postprocessed.push_back (this);
 }
 
 void
@@ -896,6 +1008,7 @@ ExportGraphBuilder::Intermediate::start_post_processing()
 	}
 
 	tmp_file->seek (0, SEEK_SET);
+	samples_read = 0;
 
 	/* called in disk-thread when exporting in realtime,
 	 * to enable freewheeling for post-proc.
@@ -939,7 +1052,7 @@ ExportGraphBuilder::SRC::sink ()
 void
 ExportGraphBuilder::SRC::add_child (FileSpec const & new_config)
 {
-	if (new_config.format->normalize() || parent._realtime) {
+	if (new_config.format->normalize() || parent._realtime || parent._parallel) {
 		add_child_to_list (new_config, intermediate_children);
 	} else {
 		add_child_to_list (new_config, children);
@@ -347,11 +347,17 @@ ExportHandler::process_timespan (samplecnt_t samples)
 int
 ExportHandler::post_process ()
 {
-	if (graph_builder->post_process ()) {
+	bool const done = graph_builder->post_process ();
+
+	std::map<std::string, float> progress;
+	graph_builder->get_postprocessing_progress (progress);
+	export_status->set_postprocessing_progress (progress);
+
+	if (done) {
 		finish_timespan ();
 		export_status->active_job = ExportStatus::Exporting;
 	} else {
-		if (graph_builder->realtime ()) {
+		if (graph_builder->realtime () || graph_builder->parallel ()) {
 			export_status->active_job = ExportStatus::Encoding;
 		} else {
 			export_status->active_job = ExportStatus::Normalizing;
@@ -52,6 +52,25 @@ ExportStatus::init ()
 	total_postprocessing_cycles = 0;
 	current_postprocessing_cycle = 0;
 	result_map.clear();
+
+	Glib::Threads::Mutex::Lock pl (_progress_lock);
+	_postprocessing_progress.clear ();
+}
+
+std::map<std::string, float>
+ExportStatus::postprocessing_progress () const
+{
+	Glib::Threads::Mutex::Lock l (_progress_lock);
+	return _postprocessing_progress;
+}
+
+void
+ExportStatus::set_postprocessing_progress (std::map<std::string, float> const& p)
+{
+	Glib::Threads::Mutex::Lock l (_progress_lock);
+	for (std::map<std::string, float>::const_iterator i = p.begin (); i != p.end (); ++i) {
+		_postprocessing_progress[i->first] = i->second;
+	}
 }
 
 void
@@ -155,6 +155,11 @@ mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
 
+apply_gain_ramp_t             ARDOUR::apply_gain_ramp             = 0;
+apply_gain_vector_to_buffer_t ARDOUR::apply_gain_vector_to_buffer = 0;
+interleave_buffer_t           ARDOUR::interleave_buffer           = 0;
+deinterleave_buffer_t         ARDOUR::deinterleave_buffer         = 0;
+
 PBD::Signal1<void, std::string>                    ARDOUR::BootMessage;
 PBD::Signal3<void, std::string, std::string, bool> ARDOUR::PluginScanMessage;
 PBD::Signal1<void, int>                            ARDOUR::PluginScanTimeout;
@@ -206,6 +211,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
+			apply_gain_ramp             = x86_avx_apply_gain_ramp;
+			apply_gain_vector_to_buffer = x86_avx_apply_gain_vector_to_buffer;
+			interleave_buffer           = x86_sse_interleave_buffer;
+			deinterleave_buffer         = x86_sse_deinterleave_buffer;
 
 			generic_mix_functions = false;
 
@@ -223,6 +232,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			apply_gain_ramp             = x86_avx_apply_gain_ramp;
+			apply_gain_vector_to_buffer = x86_avx_apply_gain_vector_to_buffer;
+			interleave_buffer           = x86_sse_interleave_buffer;
+			deinterleave_buffer         = x86_sse_deinterleave_buffer;
 
 			generic_mix_functions = false;
 
@@ -238,6 +251,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			apply_gain_ramp             = x86_avx_apply_gain_ramp;
+			apply_gain_vector_to_buffer = x86_avx_apply_gain_vector_to_buffer;
+			interleave_buffer           = x86_sse_interleave_buffer;
+			deinterleave_buffer         = x86_sse_deinterleave_buffer;
 
 			generic_mix_functions = false;
 
@@ -251,6 +268,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			apply_gain_ramp             = x86_sse_apply_gain_ramp;
+			apply_gain_vector_to_buffer = x86_sse_apply_gain_vector_to_buffer;
+			interleave_buffer           = x86_sse_interleave_buffer;
+			deinterleave_buffer         = x86_sse_deinterleave_buffer;
 
 			generic_mix_functions = false;
 		}
@@ -266,6 +287,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
+			apply_gain_ramp             = arm_neon_apply_gain_ramp;
+			apply_gain_vector_to_buffer = arm_neon_apply_gain_vector_to_buffer;
+			interleave_buffer           = arm_neon_interleave_buffer;
+			deinterleave_buffer         = arm_neon_deinterleave_buffer;
 
 			generic_mix_functions = false;
 		}
@@ -279,6 +304,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			apply_gain_ramp             = default_apply_gain_ramp;
+			apply_gain_vector_to_buffer = veclib_apply_gain_vector_to_buffer;
+			interleave_buffer           = default_interleave_buffer;
+			deinterleave_buffer         = default_deinterleave_buffer;
 
 			generic_mix_functions = false;
 
@@ -298,6 +327,10 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		apply_gain_ramp             = default_apply_gain_ramp;
+		apply_gain_vector_to_buffer = default_apply_gain_vector_to_buffer;
+		interleave_buffer           = default_interleave_buffer;
+		deinterleave_buffer         = default_deinterleave_buffer;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
@@ -23,9 +23,13 @@
 #include <cmath>
 #include <stdio.h>
 
+#include <glibmm/threads.h>
+
 #include "pbd/compose.h"
 #include "pbd/debug_rt_alloc.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/work_stealing_deque.h"
 
 #include "temporal/superclock.h"
 #include "temporal/tempo.h"
@@ -35,6 +39,7 @@
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -47,6 +52,45 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+namespace ARDOUR {
+
+/** Per-thread state of the work-stealing scheduler */
+class GraphWorker
+{
+public:
+	GraphWorker (uint32_t id, size_t queue_size)
+		: _id (id)
+	{
+		_queue.reserve (queue_size);
+		_n_steals.store (0);
+		_n_sleeps.store (0);
+		_idle_usec.store (0);
+	}
+
+	uint32_t id () const { return _id; }
+
+	/** nodes that were triggered by this thread, only this thread pushes */
+	PBD::WorkStealingDeque<ProcessNode*> _queue;
+
+	/* statistics, written by this thread, collected at the end of each cycle */
+	std::atomic<uint32_t> _n_steals;
+	std::atomic<uint32_t> _n_sleeps;
+	std::atomic<uint32_t> _idle_usec;
+
+private:
+	uint32_t _id;
+};
+
+} // namespace ARDOUR
+
+static void
+no_delete_graph_worker (GraphWorker*)
+{
+	/* GraphWorkers are owned by the Graph */
+}
+
+static Glib::Threads::Private<GraphWorker> graph_worker (no_delete_graph_worker);
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -73,9 +117,15 @@ Graph::Graph (Session& session)
 	_n_workers.store (0);
 	_idle_thread_cnt.store (0);
 	_trigger_queue_size.store (0);
+	_work_stealing.store (false);
+	_stat_steals.store (0);
+	_stat_sleeps.store (0);
+	_stat_idle_usec.store (0);
+	_cycle_start.store (0);
 
-	/* pre-allocate memory */
-	_trigger_queue.reserve (1024);
+	/* pre-allocate memory, see reserve_queues () */
+	_queue_capacity.store (1024);
+	_trigger_queue.reserve (_queue_capacity.load ());
 
 	ARDOUR::AudioEngine::instance ()->Running.connect_same_thread (engine_connections, boost::bind (&Graph::reset_thread_list, this));
 	ARDOUR::AudioEngine::instance ()->Stopped.connect_same_thread (engine_connections, boost::bind (&Graph::engine_stopped, this));
@@ -121,9 +171,25 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	start_threads (num_threads);
+}
+
+/** Start graph threads, called with the process lock held */
+void
+Graph::start_threads (uint32_t num_threads)
+{
 	/* Allow threads to run */
 	_terminate.store (0);
 
+	/* queues can only be resized while no thread uses them */
+	size_t const queue_size = _queue_capacity.load ();
+	_trigger_queue.reserve (queue_size);
+
+	/* per thread queues, [0] is used by the main thread */
+	while (_workers.size () < num_threads) {
+		_workers.push_back (new GraphWorker (_workers.size (), queue_size));
+	}
+
 	if (AudioEngine::instance ()->create_process_thread (boost::bind (&Graph::main_thread, this)) != 0) {
 		throw failed_constructor ();
 	}
@@ -139,6 +205,65 @@ Graph::reset_thread_list ()
 	}
 }
 
+/** Make sure that the queues can hold all nodes of a chain with @p n_nodes.
+ *
+ * Queues cannot be resized while graph threads may access them, so this
+ * restarts the threads if needed. Until then, a chain that is too large is
+ * processed in the calling thread. Not realtime safe, must not be called
+ * with the process lock held.
+ */
+void
+Graph::reserve_queues (size_t n_nodes)
+{
+	size_t queue_size = _queue_capacity.load ();
+
+	if (n_nodes <= queue_size) {
+		return;
+	}
+
+	while (queue_size < n_nodes) {
+		queue_size *= 2;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_session.engine ().process_lock ());
+
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("resize graph queues to %1 for %2 nodes\n", queue_size, n_nodes));
+
+	uint32_t const num_threads = AudioEngine::instance ()->process_thread_count ();
+
+	if (num_threads != 0) {
+		drop_threads ();
+	}
+
+	_queue_capacity.store (queue_size);
+
+	if (num_threads != 0) {
+		start_threads (how_many_dsp_threads ());
+	} else {
+		_trigger_queue.reserve (queue_size);
+		for (auto const& w : _workers) {
+			w->_queue.reserve (queue_size);
+		}
+	}
+}
+
+/** Process all nodes of a chain that does not fit into the queues in
+ * the calling thread, in topological order. See reserve_queues ().
+ * @return true if the chain was processed
+ */
+bool
+Graph::process_unscheduled (GraphChain const* chain)
+{
+	if (chain->_nodes_rt.size () <= _queue_capacity.load ()) {
+		return false;
+	}
+
+	for (auto const& n : chain->_nodes_rt) {
+		n->process_unscheduled ();
+	}
+	return true;
+}
+
 uint32_t
 Graph::n_threads () const
 {
@@ -162,9 +287,16 @@ Graph::drop_threads ()
 	/* Flag threads to terminate */
 	_terminate.store (1);
 
-	/* Wake-up sleeping threads */
-	uint32_t tc = _idle_thread_cnt.load();
-	assert (tc == _n_workers.load());
+	/* Wake-up sleeping threads.
+	 *
+	 * With the work-stealing scheduler, workers are not necessarily
+	 * idle between cycles; some may still be looking for work, and
+	 * go to sleep only after _terminate was set. Every thread sleeps
+	 * at most once after that, so signal once per thread (including
+	 * the main thread, which also runs graph nodes) rather than once
+	 * per currently idle thread. Surplus signals are cleared below.
+	 */
+	uint32_t tc = _n_workers.load () + 1;
 	for (guint i = 0; i < tc; ++i) {
 		_execution_sem.signal ();
 	}
@@ -178,6 +310,12 @@ Graph::drop_threads ()
 	_n_workers.store (0);
 	_idle_thread_cnt.store (0);
 
+	for (auto const& w : _workers) {
+		delete w;
+	}
+	_workers.clear ();
+	_work_stealing.store (false);
+
 	/* signal main process thread if it's waiting for an already terminated thread */
 	_callback_done_sem.signal ();
 
@@ -201,6 +339,7 @@ void
 Graph::prep ()
 {
 	if (!_graph_chain) {
+		_work_stealing.store (false);
 		return;
 	}
 	_graph_empty = true;
@@ -214,14 +353,38 @@ Graph::prep ()
 	assert (_trigger_queue_size.load() == 0);
 	assert (_graph_empty != (_graph_chain->_n_terminal_nodes > 0));
 
-	if (_trigger_queue.capacity () < _graph_chain->_nodes_rt.size ()) {
-		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
-	}
+	GraphWorker* w = graph_worker.get ();
+	bool const   ws = w && Config->get_process_graph_scheduler () == WorkStealingScheduler;
 
+	/* the queues were sized outside the process cycle, see reserve_queues () */
+	assert (_trigger_queue.capacity () >= _graph_chain->_nodes_rt.size ());
+
+	_work_stealing.store (ws);
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
 
+	if (ws) {
+		_cycle_start.store (PBD::get_microseconds ());
+
+		/* Queue initial nodes on this thread, idle workers will steal them.
+		 * The list is sorted longest critical-path first, push it in reverse
+		 * so that this thread starts with the most expensive branch.
+		 */
+		std::shared_ptr<node_list_t const> itl (_graph_chain->init_trigger_list ());
+		for (node_list_t::const_reverse_iterator i = itl->rbegin (); i != itl->rend (); ++i) {
+			w->_queue.push_back (i->get ());
+		}
+
+		size_t   n_init = w->_queue.size ();
+		uint32_t wakeup = n_init > 1 ? std::min<uint32_t> (_idle_thread_cnt.load(), n_init - 1) : 0;
+		for (uint32_t i = 0; i < wakeup; ++i) {
+			_execution_sem.signal ();
+		}
+		return;
+	}
+
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
-	for (auto const& i : _graph_chain->_init_trigger_list) {
+	std::shared_ptr<node_list_t const> itl (_graph_chain->init_trigger_list ());
+	for (auto const& i : *itl) {
 		_trigger_queue_size.fetch_add (1);
 		_trigger_queue.push_back (i.get ());
 	}
@@ -230,6 +393,22 @@ Graph::prep ()
 void
 Graph::trigger (ProcessNode* n)
 {
+	if (_work_stealing.load (std::memory_order_relaxed)) {
+		GraphWorker* w = graph_worker.get ();
+		/* Run the node on the thread that triggered it.
+		 * If the deque is full, fall back to the shared queue.
+		 */
+		if (w && w->_queue.push_back (n)) {
+			/* this thread will pick up one node itself, wake up one
+			 * idle thread for any additional work.
+			 */
+			std::atomic_thread_fence (std::memory_order_seq_cst);
+			if (w->_queue.size () > 1 && _idle_thread_cnt.load () > 0) {
+				_execution_sem.signal ();
+			}
+			return;
+		}
+	}
 	_trigger_queue_size.fetch_add (1);
 	_trigger_queue.push_back (n);
 }
@@ -248,6 +427,11 @@ Graph::reached_terminal_node ()
 		 */
 		assert (_trigger_queue_size.load() == 0);
 
+		bool const ws = _work_stealing.load ();
+		if (ws) {
+			collect_scheduler_stats ();
+		}
+
 		/* Notify caller */
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done.\n", pthread_name ()));
 
@@ -257,10 +441,16 @@ Graph::reached_terminal_node ()
 		 * When freewheeling there may be an immediate restart:
 		 * If there are more threads than CPU cores, some worker-
 		 * threads may only be "on the way" to become idle.
+		 *
+		 * This is not needed with per-thread queues: work for the
+		 * next cycle is only queued after this thread is woken up,
+		 * and a worker that is still looking for work will find it.
 		 */
-		uint32_t n_workers = _n_workers.load();
-		while (_idle_thread_cnt.load() != n_workers) {
-			sched_yield ();
+		if (!ws) {
+			uint32_t n_workers = _n_workers.load();
+			while (_idle_thread_cnt.load() != n_workers) {
+				sched_yield ();
+			}
 		}
 
 		/* Block until the a process callback */
@@ -295,6 +485,11 @@ Graph::run_one ()
 		return;
 	}
 
+	if (_work_stealing.load (std::memory_order_relaxed)) {
+		run_one_ws ();
+		return;
+	}
+
 	if (_trigger_queue.pop_front (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
@@ -346,11 +541,132 @@ Graph::run_one ()
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
 
+/** Work-stealing variant of run_one()
+ *
+ * Nodes triggered by this thread are queued on the thread's own deque,
+ * and processed LIFO, so that a route usually runs on the same CPU as the
+ * route which feeds it. Idle threads steal from the other end of other
+ * threads' deques.
+ */
+void
+Graph::run_one_ws ()
+{
+	ProcessNode* to_run = NULL;
+	GraphWorker* w      = graph_worker.get ();
+
+	assert (w);
+
+	while (!find_work (w, to_run)) {
+		/* Wait for work, fall asleep */
+		_idle_thread_cnt.fetch_add (1);
+
+		/* Work that was queued after find_work() failed, but before
+		 * this thread was counted as idle, did not wake anyone up.
+		 */
+		if (find_work (w, to_run)) {
+			PBD::atomic_dec_and_test (_idle_thread_cnt);
+			break;
+		}
+
+		w->_n_sleeps.fetch_add (1, std::memory_order_relaxed);
+
+		if (_terminate.load ()) {
+			return;
+		}
+
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name ()));
+		PBD::microseconds_t t0 = PBD::get_microseconds ();
+		_execution_sem.wait ();
+		/* only count the time since the start of the current cycle */
+		PBD::microseconds_t t1 = PBD::get_microseconds ();
+		PBD::microseconds_t ts = std::max<PBD::microseconds_t> (t0, _cycle_start.load ());
+		if (t1 > ts) {
+			w->_idle_usec.fetch_add (t1 - ts, std::memory_order_relaxed);
+		}
+
+		if (_terminate.load ()) {
+			return;
+		}
+
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name ()));
+
+		PBD::atomic_dec_and_test (_idle_thread_cnt);
+	}
+
+	/* If there is more work queued, share it with an idle thread */
+	if (w->_queue.size () > 0 && _idle_thread_cnt.load () > 0) {
+		_execution_sem.signal ();
+	}
+
+	Temporal::TempoMap::fetch ();
+
+	to_run->run (_graph_chain);
+
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one_ws()\n", pthread_name ()));
+}
+
+bool
+Graph::find_work (GraphWorker* w, ProcessNode*& to_run)
+{
+	/* own work first */
+	if (w->_queue.pop_back (to_run)) {
+		return true;
+	}
+
+	/* overflow or RTTaskChunk */
+	if (_trigger_queue.pop_front (to_run)) {
+		PBD::atomic_dec_and_test (_trigger_queue_size);
+		return true;
+	}
+
+	/* steal from other threads, starting with the next one */
+	size_t const n_workers = _workers.size ();
+	for (size_t i = 1; i < n_workers; ++i) {
+		GraphWorker* victim = _workers[(w->id () + i) % n_workers];
+		if (victim->_queue.steal (to_run)) {
+			w->_n_steals.fetch_add (1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+Graph::collect_scheduler_stats ()
+{
+	uint32_t steals    = 0;
+	uint32_t sleeps    = 0;
+	uint32_t idle_usec = 0;
+
+	for (auto const& w : _workers) {
+		steals    += w->_n_steals.exchange (0, std::memory_order_relaxed);
+		sleeps    += w->_n_sleeps.exchange (0, std::memory_order_relaxed);
+		idle_usec += w->_idle_usec.exchange (0, std::memory_order_relaxed);
+	}
+
+	_stat_steals.store (steals);
+	_stat_sleeps.store (sleeps);
+	_stat_idle_usec.store (idle_usec);
+
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("cycle stats: %1 steals, %2 sleeps, %3 usec idle\n", steals, sleeps, idle_usec));
+}
+
+GraphSchedulerStats
+Graph::scheduler_stats () const
+{
+	GraphSchedulerStats s;
+	s.n_steals  = _stat_steals.load ();
+	s.n_sleeps  = _stat_sleeps.load ();
+	s.idle_usec = _stat_idle_usec.load ();
+	return s;
+}
+
 void
 Graph::helper_thread ()
 {
-	_n_workers.fetch_add (1);
-	uint32_t id = _n_workers.load();
+	uint32_t id = _n_workers.fetch_add (1) + 1;
+
+	graph_worker.set (_workers.at (id));
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -382,6 +698,8 @@ Graph::main_thread ()
 {
 	/* first time setup */
 
+	graph_worker.set (_workers.at (0));
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 
@@ -447,6 +765,11 @@ Graph::process_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes, sam
 	_process_retval      = 0;
 	_process_need_butler = false;
 
+	if (process_unscheduled (_graph_chain)) {
+		need_butler = _process_need_butler;
+		return _process_retval;
+	}
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for non-silent process\n");
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
@@ -476,30 +799,11 @@ Graph::routes_no_roll (std::shared_ptr<GraphChain> chain, pframes_t nframes, sam
 	_process_need_butler    = false;
 	_process_non_rt_pending = non_rt_pending;
 
-	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for no-roll process\n");
-	_callback_start_sem.signal ();
-	_callback_done_sem.wait ();
-	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
-
-	return _process_retval;
-}
-
-int
-Graph::silence_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes)
-{
-	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("silence graph execution from %1 for = %2\n", nframes));
-
-	if (_terminate.load ()) {
-		return 0;
+	if (process_unscheduled (_graph_chain)) {
+		return _process_retval;
 	}
 
-	_graph_chain         = chain.get ();
-	_process_nframes     = nframes;
-	_process_mode        = Silence;
-	_process_retval      = 0;
-	_process_need_butler = false;
-
-	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for silence process\n");
+	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for no-roll process\n");
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
@@ -520,6 +824,10 @@ Graph::process_io_plugs (std::shared_ptr<GraphChain> chain, pframes_t nframes, s
 	_process_nframes      = nframes;
 	_process_start_sample = start_sample;
 
+	if (process_unscheduled (_graph_chain)) {
+		return _process_retval;
+	}
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for IOPlug processing\n");
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
@@ -545,10 +853,6 @@ Graph::process_one_route (Route* route)
 		case NoRoll:
 			retval = route->no_roll (_process_nframes, _process_start_sample, _process_end_sample, _process_non_rt_pending);
 			break;
-		case Silence:
-			retval = 0;
-			route->silence (_process_nframes);
-			break;
 	}
 
 	if (retval) {
@@ -579,21 +883,31 @@ Graph::process_tasklist (RTTaskList const& rt)
 {
 	assert (_trigger_queue_size.load() == 0);
 
-	std::vector<RTTask> const& tasks = rt.tasks ();
-	if (tasks.empty ()) {
+	size_t const n_chunks = rt.n_chunks ();
+	if (n_chunks == 0) {
 		return;
 	}
 
-	_trigger_queue_size.store (tasks.size ());
-	_terminal_refcnt.store (tasks.size ());
+	/* After a work-stealing cycle some workers may still be looking for
+	 * work. Tasks are queued before the main thread is woken up, so
+	 * they must not be picked up by a worker that is not yet idle.
+	 */
+	uint32_t n_workers = _n_workers.load();
+	while (_idle_thread_cnt.load() != n_workers) {
+		sched_yield ();
+	}
+
+	_trigger_queue_size.store (n_chunks);
+	_terminal_refcnt.store (n_chunks);
 	_graph_empty = false;
 
-	for (auto const& t : tasks) {
-		_trigger_queue.push_back (const_cast<RTTask*>(&t));
+	RTTaskChunk* chunks = rt.chunks ();
+	for (size_t i = 0; i < n_chunks; ++i) {
+		_trigger_queue.push_back (&chunks[i]);
 	}
 
 	_graph_chain = 0;
-	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for RTTask processing\n");
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("wake graph for RTTask processing, %1 chunks\n", n_chunks));
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
@@ -602,21 +916,29 @@ Graph::process_tasklist (RTTaskList const& rt)
 /* ****************************************************************************/
 
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
+	: _init_trigger_list (new node_list_t)
 {
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphChain constructed in thread:%1\n", pthread_name ()));
 	/* This will become the number of nodes that do not feed any other node;
 	 * once we have processed this number of those nodes, we have finished.
 	 */
 	_n_terminal_nodes = 0;
+	_critical_path.store (0);
+	_total_cost.store (0);
+
+	node_list_t init_trigger_list;
 
 	/* copy nodelist to _nodes_rt, prepare GraphNodes for this graph */
 	for (auto const& ni : nodelist) {
-		RCUWriter<GraphActivision::ActivationMap>         wa (ni->_activation_set);
-		RCUWriter<GraphActivision::RefCntMap>             wr (ni->_init_refcount);
-		std::shared_ptr<GraphActivision::ActivationMap> ma (wa.get_copy ());
-		std::shared_ptr<GraphActivision::RefCntMap>     mr (wr.get_copy ());
+		RCUWriter<GraphActivision::ActivationMap>            wa (ni->_activation_set);
+		RCUWriter<GraphActivision::ActivationOrderMap>       wo (ni->_activation_order);
+		RCUWriter<GraphActivision::RefCntMap>                wr (ni->_init_refcount);
+		std::shared_ptr<GraphActivision::ActivationMap>      ma (wa.get_copy ());
+		std::shared_ptr<GraphActivision::ActivationOrderMap> mo (wo.get_copy ());
+		std::shared_ptr<GraphActivision::RefCntMap>          mr (wr.get_copy ());
 		(*mr)[this] = 0;
 		(*ma)[this].clear ();
+		(*mo)[this].clear ();
 		_nodes_rt.push_back (ni);
 	}
 
@@ -648,7 +970,7 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 
 		if (!has_input) {
 			/* no input, so this node needs to be triggered initially to get things going */
-			_init_trigger_list.push_back (ni);
+			init_trigger_list.push_back (ni);
 		}
 
 		if (!has_output) {
@@ -658,19 +980,111 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 			_n_terminal_nodes += 1;
 		}
 	}
+
+	{
+		RCUWriter<node_list_t> wi (_init_trigger_list);
+		*wi.get_copy () = init_trigger_list;
+	}
+
+	rank ();
+
 	dump ();
 }
 
+void
+GraphChain::rank ()
+{
+	/* Weight each node by the longest path from the node to the end
+	 * of the graph, using the DSP cost measured during past cycles.
+	 * When several nodes are ready, the ones with the longest remaining
+	 * path are scheduled first, since they decide when the cycle ends.
+	 */
+	CostMap remaining;
+	double  total_cost    = 0;
+	double  critical_path = 0;
+	for (auto const& ni : _nodes_rt) {
+		total_cost   += node_cost (ni.get ());
+		critical_path = std::max (critical_path, remaining_path (ni, remaining));
+	}
+
+	_total_cost.store (total_cost);
+	_critical_path.store (critical_path);
+
+	auto longest_path_first = [&remaining] (node_ptr_t const& a, node_ptr_t const& b) {
+		return remaining[a.get ()] > remaining[b.get ()];
+	};
+
+	/* The orders are used by the process threads, only replace the
+	 * ones that changed (RCU).
+	 */
+	for (auto const& ni : _nodes_rt) {
+		std::shared_ptr<GraphActivision::ActivationMap const> ma (ni->_activation_set.reader ());
+		node_set_t const&                                     as = ma->at (this);
+		node_list_t                                           ao (as.begin (), as.end ());
+		ao.sort (longest_path_first);
+
+		std::shared_ptr<GraphActivision::ActivationOrderMap const> cur (ni->_activation_order.reader ());
+		GraphActivision::ActivationOrderMap::const_iterator        c = cur->find (this);
+		if (c != cur->end () && c->second == ao) {
+			continue;
+		}
+
+		RCUWriter<GraphActivision::ActivationOrderMap>       wo (ni->_activation_order);
+		std::shared_ptr<GraphActivision::ActivationOrderMap> mo (wo.get_copy ());
+		(*mo)[this].swap (ao);
+	}
+
+	node_list_t itl (*_init_trigger_list.reader ());
+	node_list_t sorted (itl);
+	sorted.sort (longest_path_first);
+	if (sorted != itl) {
+		RCUWriter<node_list_t> wi (_init_trigger_list);
+		wi.get_copy ()->swap (sorted);
+	}
+}
+
+double
+GraphChain::node_cost (GraphNode const* n) const
+{
+	/* nodes that have not been processed yet count as 1 usec,
+	 * so that the critical path is the longest chain of nodes */
+	return std::max<double> (1.0, n->dsp_cost ());
+}
+
+double
+GraphChain::remaining_path (node_ptr_t const& n, CostMap& cache) const
+{
+	CostMap::const_iterator c = cache.find (n.get ());
+	if (c != cache.end ()) {
+		return c->second;
+	}
+
+	/* hold a reference, other chains may modify the node's map meanwhile */
+	std::shared_ptr<GraphActivision::ActivationMap const> m (n->_activation_set.reader ());
+
+	double longest = 0;
+	for (auto const& i : m->at (this)) {
+		longest = std::max (longest, remaining_path (i, cache));
+	}
+
+	double rv = node_cost (n.get ()) + longest;
+	cache[n.get ()] = rv;
+	return rv;
+}
+
 GraphChain::~GraphChain ()
 {
 	/* clear chain */
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("~GraphChain destroyed in thread:%1\n", pthread_name ()));
 	for (auto const& ni : _nodes_rt) {
-		RCUWriter<GraphActivision::ActivationMap>         wa (ni->_activation_set);
-		RCUWriter<GraphActivision::RefCntMap>             wr (ni->_init_refcount);
-		std::shared_ptr<GraphActivision::ActivationMap> ma (wa.get_copy ());
-		std::shared_ptr<GraphActivision::RefCntMap>     mr (wr.get_copy ());
+		RCUWriter<GraphActivision::ActivationMap>            wa (ni->_activation_set);
+		RCUWriter<GraphActivision::ActivationOrderMap>       wo (ni->_activation_order);
+		RCUWriter<GraphActivision::RefCntMap>                wr (ni->_init_refcount);
+		std::shared_ptr<GraphActivision::ActivationMap>      ma (wa.get_copy ());
+		std::shared_ptr<GraphActivision::ActivationOrderMap> mo (wo.get_copy ());
+		std::shared_ptr<GraphActivision::RefCntMap>          mr (wr.get_copy ());
 		mr->erase (this);
+		mo->erase (this);
 		ma->erase (this);
 	}
 }
@@ -733,11 +1147,12 @@ GraphChain::dump () const
 	}
 
 	DEBUG_TRACE (DEBUG::Graph, " --- trigger list ---\n");
-	for (auto const& ni : _init_trigger_list) {
+	for (auto const& ni : *init_trigger_list ()) {
 		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", ni->graph_node_name (), ni->init_refcount (this)));
 	}
 
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("final activation refcount: %1\n", _n_terminal_nodes));
+	DEBUG_TRACE (DEBUG::Graph, string_compose ("critical path: %1 usec of %2 usec total, max. speedup: %3\n", critical_path (), total_cost (), max_parallel_speedup ()));
 	DEBUG_TRACE (DEBUG::Graph, "-->8-- END Graph dump ------------------------\n");
 #endif
 }
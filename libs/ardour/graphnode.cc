@@ -19,6 +19,7 @@
  */
 
 #include "pbd/atomic.h"
+#include "pbd/microseconds.h"
 
 #include "ardour/graphnode.h"
 #include "ardour/graph.h"
@@ -28,6 +29,7 @@ using namespace ARDOUR;
 
 GraphActivision::GraphActivision ()
 	: _activation_set (new ActivationMap)
+	, _activation_order (new ActivationOrderMap)
 	, _init_refcount (new RefCntMap)
 {
 }
@@ -39,6 +41,13 @@ GraphActivision::activation_set (GraphChain const* const g) const
 	return m->at (g);
 }
 
+node_list_t const&
+GraphActivision::activation_order (GraphChain const* const g) const
+{
+	std::shared_ptr<ActivationOrderMap const> m (_activation_order.reader ());
+	return m->at (g);
+}
+
 int
 GraphActivision::init_refcount (GraphChain const* const g) const
 {
@@ -52,6 +61,7 @@ GraphNode::GraphNode (std::shared_ptr<Graph> graph)
 	: _graph (graph)
 {
 	_refcount.store (0);
+	_dsp_cost.store (0);
 }
 
 void
@@ -64,7 +74,18 @@ GraphNode::prep (GraphChain const* chain)
 void
 GraphNode::run (GraphChain const* chain)
 {
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
 	process ();
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+
+	/* Keep a running average of the node's DSP cost,
+	 * used by GraphChain to find the critical path.
+	 */
+	if (t1 > t0) {
+		float cost = _dsp_cost.load (std::memory_order_relaxed);
+		_dsp_cost.store (cost + .05f * ((float)(t1 - t0) - cost), std::memory_order_relaxed);
+	}
+
 	finish (chain);
 }
 
@@ -86,13 +107,25 @@ GraphNode::trigger ()
 void
 GraphNode::finish (GraphChain const* chain)
 {
-	node_set_t::iterator i;
-	bool                 feeds = false;
+	/* hold a reference, the order may be replaced by GraphChain::rank () */
+	std::shared_ptr<ActivationOrderMap const> m (_activation_order.reader ());
+	node_list_t const&                        nodes = m->at (chain);
+	bool const                                feeds = !nodes.empty ();
 
-	/* Notify downstream nodes that depend on this node */
-	for (auto const& i : activation_set (chain)) {
-		i->trigger ();
-		feeds = true;
+	/* Notify downstream nodes that depend on this node.
+	 * Nodes are sorted by the length of the remaining critical path.
+	 * With a FIFO queue the most expensive branch is triggered first,
+	 * with a per-thread LIFO queue it is triggered last, so that
+	 * this thread continues with it.
+	 */
+	if (_graph->work_stealing ()) {
+		for (node_list_t::const_reverse_iterator i = nodes.rbegin (); i != nodes.rend (); ++i) {
+			(*i)->trigger ();
+		}
+	} else {
+		for (auto const& i : nodes) {
+			i->trigger ();
+		}
 	}
 
 	if (!feeds) {
@@ -24,8 +24,10 @@
 #include "libardour-config.h"
 #endif
 
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <list>
 #include <string>
 #include <climits>
 #include <cerrno>
@@ -40,12 +42,15 @@
 #include "pbd/gstdio_compat.h"
 #include <glibmm.h>
 
+#include <boost/bind.hpp>
 #include <boost/scoped_array.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_array.hpp>
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
 
 #include "evoral/SMF.h"
 
@@ -254,7 +259,8 @@ compose_status_message (const string& path,
 
 static void
 write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
-                               vector<std::shared_ptr<Source> >& newfiles)
+                               vector<std::shared_ptr<Source> >& newfiles,
+                               volatile float& progress)
 {
 	const samplecnt_t nframes = ResampledImportableSource::blocksize;
 	std::shared_ptr<AudioFileSource> afs;
@@ -275,7 +281,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 	std::shared_ptr<AudioSource> s = std::dynamic_pointer_cast<AudioSource> (newfiles[0]);
 	assert (s);
 
-	status.progress = 0.0f;
+	progress = 0.0f;
 	float progress_multiplier = 1;
 	float progress_base = 0;
 	const float progress_length = source->ratio() * source->length();
@@ -299,7 +305,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			peak = compute_peak (data.get(), nread, peak);
 
 			read_count += nread / channels;
-			status.progress = 0.5 * read_count / progress_length;
+			progress = 0.5 * read_count / progress_length;
 		}
 
 		if (peak >= 1) {
@@ -317,7 +323,6 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 	while (!status.cancel) {
 
 		samplecnt_t nread, nfread;
-		uint32_t x;
 		uint32_t chn;
 
 		if ((nread = source->read (data.get(), nframes * channels)) == 0) {
@@ -342,11 +347,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		/* de-interleave */
 
 		for (chn = 0; chn < channels; ++chn) {
-
-			samplecnt_t n;
-			for (x = chn, n = 0; n < nfread; x += channels, ++n) {
-				channel_data[chn][n] = (Sample) data[x];
-			}
+			deinterleave_buffer (channel_data[chn].get(), data.get() + chn, nfread, channels);
 		}
 
 		/* flush to disk */
@@ -358,7 +359,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		}
 
 		read_count += nfread;
-		status.progress = progress_base + progress_multiplier * read_count / progress_length;
+		progress = progress_base + progress_multiplier * read_count / progress_length;
 	}
 }
 
@@ -599,6 +600,178 @@ Session::deinterlace_midi_region (std::shared_ptr<MidiRegion> mr)
 	}
 }
 
+namespace {
+
+/** Audio files that are written concurrently by a pool of worker threads.
+ *
+ * Sources are opened and created by the import thread, because that
+ * touches session state. Workers only decode, resample and write the data,
+ * which also builds the peaks. The number of files that are open at the
+ * same time is bounded: add() blocks while every worker has a file
+ * waiting for it.
+ */
+class ImportPipeline
+{
+public:
+	ImportPipeline (ImportStatus& status, uint32_t n_threads)
+		: _status (status)
+		, _base (status.current)
+		, _n_done (0)
+		, _max_queued (n_threads)
+		, _run (true)
+	{
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			PBD::Thread* t = PBD::Thread::create (boost::bind (&ImportPipeline::work, this), string_compose ("Import %1", i));
+			if (t) {
+				_threads.push_back (t);
+			}
+		}
+	}
+
+	~ImportPipeline ()
+	{
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			_run = false;
+			_cond.broadcast ();
+		}
+		for (vector<PBD::Thread*>::iterator i = _threads.begin (); i != _threads.end (); ++i) {
+			(*i)->join ();
+			delete *i;
+		}
+	}
+
+	bool ok () const {
+		return !_threads.empty ();
+	}
+
+	void add (std::string const& path, std::shared_ptr<ImportableSource> source, vector<std::shared_ptr<Source> > const& newfiles, std::string const& msg)
+	{
+		std::shared_ptr<Job> job (new Job (path, source, newfiles, msg));
+
+		Glib::Threads::Mutex::Lock lm (_lock);
+		while (_queue.size () >= _max_queued && !_status.cancel) {
+			wait_and_update_status ();
+		}
+		if (_status.cancel) {
+			return;
+		}
+		_queue.push_back (job);
+		_cond.broadcast ();
+	}
+
+	/** count a file that was imported by the calling thread */
+	void add_done ()
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		++_n_done;
+		update_status ();
+	}
+
+	/** wait until all files are written, or the import was cancelled */
+	void wait ()
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (_status.cancel) {
+			_queue.clear ();
+		}
+		while (!_queue.empty () || !_active.empty ()) {
+			wait_and_update_status ();
+			if (_status.cancel) {
+				_queue.clear ();
+			}
+		}
+		update_status ();
+	}
+
+private:
+	struct Job {
+		Job (std::string const& p, std::shared_ptr<ImportableSource> s, vector<std::shared_ptr<Source> > const& f, std::string const& m)
+			: path (p), source (s), newfiles (f), msg (m), progress (0) {}
+
+		std::string                       path;
+		std::shared_ptr<ImportableSource> source;
+		vector<std::shared_ptr<Source> >  newfiles;
+		std::string                       msg;
+		volatile float                    progress;
+	};
+
+	typedef std::list<std::shared_ptr<Job> > Jobs;
+
+	void work ()
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		while (true) {
+			while (_run && _queue.empty ()) {
+				_cond.wait (_lock);
+			}
+			if (!_run) {
+				return;
+			}
+
+			std::shared_ptr<Job> job = _queue.front ();
+			_queue.pop_front ();
+			_active.push_back (job);
+			_cond.broadcast ();
+
+			lm.release ();
+
+			try {
+				write_audio_data_to_new_files (job->source.get (), _status, job->newfiles, job->progress);
+			} catch (...) {
+				error << string_compose (_("Import: error reading \"%1\""), job->path) << endmsg;
+				_status.cancel = true;
+			}
+			/* close the file as soon as possible */
+			job->source.reset ();
+
+			lm.acquire ();
+
+			_active.remove (job);
+			++_n_done;
+			_cond.broadcast ();
+		}
+	}
+
+	/* _lock must be held */
+	void wait_and_update_status ()
+	{
+		/* wake up periodically to report progress and to notice cancellation */
+		_cond.wait_until (_lock, g_get_monotonic_time () + 100000);
+		update_status ();
+	}
+
+	/* _lock must be held */
+	void update_status ()
+	{
+		/* ImportProgressWindow shows (current - 1 + progress) / total,
+		 * spread the progress of all active files accordingly.
+		 */
+		float done = _n_done;
+		for (Jobs::const_iterator i = _active.begin (); i != _active.end (); ++i) {
+			done += (*i)->progress;
+		}
+		if (!_active.empty ()) {
+			_status.doing_what = _active.front ()->msg;
+		}
+		_status.current  = _base + floorf (done);
+		_status.progress = done - floorf (done);
+	}
+
+	ImportStatus&          _status;
+	uint32_t               _base;
+	uint32_t               _n_done;
+	size_t                 _max_queued;
+	bool                   _run;
+	Jobs                   _queue;
+	Jobs                   _active;
+	vector<PBD::Thread*>   _threads;
+	Glib::Threads::Mutex   _lock;
+	Glib::Threads::Cond    _cond;
+};
+
+} // anonymous namespace
+
 static vector<string>
 unique_track_names (const vector<string>& n)
 {
@@ -638,6 +811,17 @@ Session::import_files (ImportStatus& status)
 
 	status.sources.clear ();
 
+	boost::scoped_ptr<ImportPipeline> pipeline;
+
+	if (Config->get_parallel_import () && status.paths.size () > 1) {
+		/* import is disk and CPU bound (decoding, resampling), use a few threads */
+		uint32_t const n_threads = std::max<uint32_t> (1, std::min<uint32_t> (8, hardware_concurrency () - 1));
+		pipeline.reset (new ImportPipeline (status, std::min<uint32_t> (n_threads, status.paths.size ())));
+		if (!pipeline->ok ()) {
+			pipeline.reset ();
+		}
+	}
+
 	for (vector<string>::const_iterator p = status.paths.begin(); p != status.paths.end() && !status.cancel; ++p) {
 
 		std::shared_ptr<ImportableSource> source;
@@ -753,10 +937,14 @@ Session::import_files (ImportStatus& status)
 			}
 		}
 
-		if (source) { // audio
+		if (source && pipeline) { // audio, written by a worker thread
+			pipeline->add (*p, source, newfiles, compose_status_message (*p, source->samplerate(),
+			                                                             sample_rate(), status.current, status.total));
+			continue;
+		} else if (source) { // audio
 			status.doing_what = compose_status_message (*p, source->samplerate(),
 			                                            sample_rate(), status.current, status.total);
-			write_audio_data_to_new_files (source.get(), status, newfiles);
+			write_audio_data_to_new_files (source.get(), status, newfiles, status.progress);
 		} else if (smf_reader) { // midi
 			status.doing_what = string_compose(_("Loading MIDI file %1"), *p);
 			write_midi_data_to_new_files (smf_reader.get(), status, newfiles, status.split_midi_channels);
@@ -771,8 +959,19 @@ Session::import_files (ImportStatus& status)
 			}
 		}
 
-		++status.current;
-		status.progress = 0;
+		if (pipeline) {
+			pipeline->add_done ();
+		} else {
+			++status.current;
+			status.progress = 0;
+		}
+	}
+
+	if (pipeline) {
+		/* wait for the workers, before the headers are updated, or
+		 * the files are removed on cancel */
+		pipeline->wait ();
+		pipeline.reset ();
 	}
 
 	if (!status.cancel) {
@@ -1999,6 +1999,11 @@ LuaBindings::common (lua_State* L)
 		.deriveWSPtrClass <LuaProc, Plugin> ("LuaProc")
 		.addFunction ("shmem", &LuaProc::instance_shm)
 		.addFunction ("table", &LuaProc::instance_ref)
+		.addFunction ("clear_stats", &LuaProc::clear_stats)
+		.addFunction ("gc_deferred_cycles", &LuaProc::gc_deferred_cycles)
+		.addRefFunction ("get_gc_stats", &LuaProc::get_gc_stats)
+		.addRefFunction ("get_memory_stats", &LuaProc::get_memory_stats)
+		.addRefFunction ("get_alloc_stats", &LuaProc::get_alloc_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <PluginInsert, Processor> ("PluginInsert")
@@ -3256,6 +3261,10 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("latency", &ARDOUR::DSP::Convolution::latency)
 		.addFunction ("n_inputs", &ARDOUR::DSP::Convolution::n_inputs)
 		.addFunction ("n_outputs", &ARDOUR::DSP::Convolution::n_outputs)
+		.addFunction ("latency_mode", &ARDOUR::DSP::Convolution::latency_mode)
+		.addFunction ("set_latency_mode", &ARDOUR::DSP::Convolution::set_latency_mode)
+		.addFunction ("dsp_load", &ARDOUR::DSP::Convolution::dsp_load)
+		.addFunction ("late_cycles", &ARDOUR::DSP::Convolution::late_cycles)
 		.endClass ()
 
 		.beginClass <DSP::Convolver::IRSettings> ("IRSettings")
@@ -3310,6 +3319,13 @@ LuaBindings::common (lua_State* L)
 		.addConst ("Stereo", DSP::Convolver::Stereo)
 		.endNamespace ()
 
+		.beginNamespace ("ConvolutionLatencyMode")
+		.addConst ("Unthreaded", DSP::Convolution::Unthreaded)
+		.addConst ("LowLatency", DSP::Convolution::LowLatency)
+		.addConst ("Balanced", DSP::Convolution::Balanced)
+		.addConst ("LowCPU", DSP::Convolution::LowCPU)
+		.endNamespace ()
+
 		.beginClass <DSP::DspShm> ("DspShm")
 		.addConstructor<void (*) (size_t)> ()
 		.addFunction ("allocate", &DSP::DspShm::allocate)
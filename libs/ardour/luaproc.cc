@@ -34,6 +34,7 @@
 #include "ardour/luascripting.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/plugin.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 
 #include "LuaBridge/LuaBridge.h"
@@ -43,17 +44,29 @@
 using namespace ARDOUR;
 using namespace PBD;
 
+/* size of the memory arena used by each instance */
+static const size_t luaproc_pool_size = 3145728;
+
+/* adaptive GC: a step is deferred when more than half of the
+ * process cycle has passed, but for no more than this many cycles,
+ * and only as long as less than half of the arena is used.
+ */
+static const uint32_t luaproc_max_gc_skip = 32;
+
 LuaProc::LuaProc (AudioEngine& engine,
                   Session& session,
                   const std::string &script)
 	: Plugin (engine, session)
-	, _mempool ("LuaProc", 3145728)
-#ifdef USE_TLSF
-	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
-#elif defined USE_MALLOC
+	, _mempool ("LuaProc", luaproc_pool_size)
+	, _mem_used (0)
+	, _mem_peak (0)
+	, _mem_failed (0)
+	, _mem_allocs (0)
+	, _mem_gc_debt (0)
+#ifdef USE_MALLOC
 	, lua (true, true)
 #else
-	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
+	, lua (lua_newstate (&LuaProc::lalloc, this))
 #endif
 	, _lua_dsp (0)
 	, _lua_latency (0)
@@ -70,7 +83,15 @@ LuaProc::LuaProc (AudioEngine& engine,
 	, _configured (false)
 	, _has_midi_input (false)
 	, _has_midi_output (false)
+	, _gc_adaptive (false)
+	, _gc_skipped (0)
+	, _gc_deferred (0)
+	, _allocs_cycle_start (0)
+	, _allocs_max (0)
+	, _allocs_sum (0)
+	, _allocs_cnt (0)
 {
+	_stat_reset.store (0);
 	init ();
 
 	/* when loading a session, or passing a processor,
@@ -83,13 +104,16 @@ LuaProc::LuaProc (AudioEngine& engine,
 
 LuaProc::LuaProc (const LuaProc &other)
 	: Plugin (other)
-	, _mempool ("LuaProc", 3145728)
-#ifdef USE_TLSF
-	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
-#elif defined USE_MALLOC
+	, _mempool ("LuaProc", luaproc_pool_size)
+	, _mem_used (0)
+	, _mem_peak (0)
+	, _mem_failed (0)
+	, _mem_allocs (0)
+	, _mem_gc_debt (0)
+#ifdef USE_MALLOC
 	, lua (true, true)
 #else
-	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
+	, lua (lua_newstate (&LuaProc::lalloc, this))
 #endif
 	, _lua_dsp (0)
 	, _lua_latency (0)
@@ -104,7 +128,15 @@ LuaProc::LuaProc (const LuaProc &other)
 	, _configured (false)
 	, _has_midi_input (false)
 	, _has_midi_output (false)
+	, _gc_adaptive (false)
+	, _gc_skipped (0)
+	, _gc_deferred (0)
+	, _allocs_cycle_start (0)
+	, _allocs_max (0)
+	, _allocs_sum (0)
+	, _allocs_cnt (0)
 {
+	_stat_reset.store (0);
 	init ();
 
 	if (load_script ()) {
@@ -189,6 +221,49 @@ LuaProc::drop_references ()
 	Plugin::drop_references ();
 }
 
+void*
+LuaProc::lalloc (void* self, void* ptr, size_t osize, size_t nsize)
+{
+	LuaProc* p = static_cast<LuaProc*> (self);
+
+	/* if ptr is NULL, osize is the type of object being allocated */
+	size_t const old = ptr ? osize : 0;
+
+#ifdef USE_TLSF
+	void* rv = PBD::TLSF::lalloc (&p->_mempool, ptr, osize, nsize);
+#elif !defined USE_MALLOC
+	void* rv = PBD::ReallocPool::lalloc (&p->_mempool, ptr, osize, nsize);
+#else
+	void* rv = 0;
+	if (nsize == 0) {
+		free (ptr);
+	} else {
+		rv = realloc (ptr, nsize);
+	}
+#endif
+
+	if (nsize == 0) {
+		p->_mem_used -= old;
+		return rv;
+	}
+	if (!rv) {
+		++p->_mem_failed;
+		return rv;
+	}
+
+	++p->_mem_allocs;
+	if (nsize > old) {
+		p->_mem_used    += nsize - old;
+		p->_mem_gc_debt += nsize - old;
+	} else {
+		p->_mem_used    -= old - nsize;
+	}
+	if (p->_mem_used > p->_mem_peak) {
+		p->_mem_peak = p->_mem_used;
+	}
+	return rv;
+}
+
 std::weak_ptr<Route>
 LuaProc::route () const
 {
@@ -748,6 +823,8 @@ LuaProc::connect_and_run (BufferSet& bufs,
 		}
 	}
 
+	_allocs_cycle_start = _mem_allocs;
+
 #ifdef WITH_LUAPROC_STATS
 	int64_t t0 = g_get_monotonic_time ();
 #endif
@@ -920,7 +997,7 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	int64_t t1 = g_get_monotonic_time ();
 #endif
 
-	lua.collect_garbage_step ();
+	run_gc (nframes);
 #ifdef WITH_LUAPROC_STATS
 	if (++_stats_cnt > 0) {
 		int64_t t2 = g_get_monotonic_time ();
@@ -935,6 +1012,97 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	return 0;
 }
 
+void
+LuaProc::run_gc (pframes_t nframes)
+{
+	int canderef (1);
+	if (_stat_reset.compare_exchange_strong (canderef, 0)) {
+		_gc_stats.reset ();
+		_gc_deferred = 0;
+		_allocs_max  = 0;
+		_allocs_sum  = 0;
+		_allocs_cnt  = 0;
+		_mem_peak    = _mem_used;
+		_mem_failed  = 0;
+	}
+
+	size_t const allocs = _mem_allocs - _allocs_cycle_start;
+	_allocs_max  = std::max (_allocs_max, allocs);
+	_allocs_sum += allocs;
+	++_allocs_cnt;
+
+	bool const adaptive = Config->get_lua_dsp_adaptive_gc ();
+	if (adaptive != _gc_adaptive) {
+		/* In adaptive mode the collector only runs when stepped
+		 * explicitly, and not when the DSP script allocates memory.
+		 */
+		_gc_adaptive = adaptive;
+		_gc_skipped  = 0;
+		_mem_gc_debt = 0;
+		lua_gc (lua.getState (), adaptive ? LUA_GCSTOP : LUA_GCRESTART, 0);
+	}
+
+	if (!_gc_adaptive) {
+		_gc_stats.start ();
+		lua.collect_garbage_step ();
+		_gc_stats.update ();
+		return;
+	}
+
+	if (_gc_skipped < luaproc_max_gc_skip && _mem_used < luaproc_pool_size / 2 && !_engine.freewheeling ()) {
+		/* defer GC unless the cycle has slack */
+		if (_engine.samples_since_cycle_start () > _engine.samples_per_cycle () / 2) {
+			++_gc_skipped;
+			++_gc_deferred;
+			return;
+		}
+	}
+
+	/* do GC work for all memory allocated since the last step [kB] */
+	int const debt = std::max<size_t> (1, std::min<size_t> (_mem_gc_debt, luaproc_pool_size) / 1024);
+	_mem_gc_debt = 0;
+	_gc_skipped  = 0;
+
+	_gc_stats.start ();
+	lua.collect_garbage_step (debt);
+	_gc_stats.update ();
+}
+
+bool
+LuaProc::get_gc_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, double& dev) const
+{
+	return _gc_stats.get_stats (min, max, avg, dev);
+}
+
+size_t
+LuaProc::get_memory_stats (size_t& used, size_t& peak, size_t& pool_size) const
+{
+	used      = _mem_used;
+	peak      = _mem_peak;
+#ifdef USE_MALLOC
+	pool_size = 0;
+#else
+	pool_size = luaproc_pool_size;
+#endif
+	return _mem_failed;
+}
+
+bool
+LuaProc::get_alloc_stats (double& avg, size_t& max) const
+{
+	if (_allocs_cnt == 0) {
+		return false;
+	}
+	avg = _allocs_sum / (double) _allocs_cnt;
+	max = _allocs_max;
+	return true;
+}
+
+void
+LuaProc::clear_stats ()
+{
+	_stat_reset.store (1);
+}
 
 void
 LuaProc::add_state (XMLNode* root) const
@@ -303,6 +303,7 @@ MidiModel::NoteDiffCommand::operator() ()
 
 			case Length:
 				i->note->set_length (i->new_value.get_beats());
+				_model->invalidate_note_index ();
 				break;
 
 			}
@@ -418,6 +419,7 @@ MidiModel::NoteDiffCommand::undo ()
 
 			case Length:
 				i->note->set_length (i->old_value.get_beats());
+				_model->invalidate_note_index ();
 				break;
 			}
 		}
@@ -1354,18 +1356,17 @@ MidiModel::get_state() const
 Evoral::Sequence<MidiModel::TimeType>::NotePtr
 MidiModel::find_note (NotePtr other)
 {
-	Notes::iterator l = notes().lower_bound(other);
-
-	if (l != notes().end()) {
-		for (; (*l)->time() == other->time(); ++l) {
-			/* NB: compare note contents, not note pointers.
-			   If "other" was a ptr to a note already in
-			   the model, we wouldn't be looking for it,
-			   would we now?
-			*/
-			if (**l == *other) {
-				return *l;
-			}
+	std::vector<NotePtr> candidates;
+	get_notes_overlapping_unlocked (candidates, other->time(), other->time(), 1 << other->channel());
+
+	for (std::vector<NotePtr>::const_iterator l = candidates.begin(); l != candidates.end(); ++l) {
+		/* NB: compare note contents, not note pointers.
+		   If "other" was a ptr to a note already in
+		   the model, we wouldn't be looking for it,
+		   would we now?
+		*/
+		if (**l == *other) {
+			return *l;
 		}
 	}
 
@@ -1447,8 +1448,6 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 	TimeType sa = note->time();
 	TimeType ea  = note->end_time();
 
-	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<TimeType>(0, TimeType(), TimeType(), note->note()));
 	set<NotePtr> to_be_deleted;
 	bool set_note_length = false;
 	bool set_note_time = false;
@@ -1457,8 +1456,15 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1 checking overlaps for note %2 @ %3\n", this, (int)note->note(), note->time()));
 
-	for (Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+	/* candidates from the note index, the overlap type is classified below */
+	std::vector<NotePtr> overlapping;
+	get_notes_overlapping_unlocked (overlapping, sa, ea, 1 << note->channel());
+
+	for (std::vector<NotePtr>::const_iterator i = overlapping.begin(); i != overlapping.end(); ++i) {
+
+		if ((*i)->note() != note->note()) {
+			continue;
+		}
 
 		TimeType sb = (*i)->time();
 		TimeType eb = (*i)->end_time();
@@ -1499,6 +1505,7 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 					cmd->change (*i, NoteDiffCommand::Length, (note->time() - (*i)->time()));
 				}
 				(*i)->set_length (note->time() - (*i)->time());
+				invalidate_note_index ();
 				break;
 			case InsertMergeTruncateAddition:
 				set_note_time = true;
@@ -1511,6 +1518,7 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 					cmd->change ((*i), NoteDiffCommand::Length, note->end_time() - (*i)->time());
 				}
 				(*i)->set_length (note->end_time() - (*i)->time());
+				invalidate_note_index ();
 				return -1; /* do not add the new note */
 				break;
 			default:
@@ -145,6 +145,48 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+float
+default_apply_gain_ramp (ARDOUR::Sample * buf, pframes_t nframes, float gain, float target, float coeff)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		buf[i] *= gain;
+		gain += coeff * (target - gain);
+	}
+	return gain;
+}
+
+void
+default_apply_gain_vector_to_buffer (ARDOUR::Sample * buf, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		buf[i] *= gain[i];
+	}
+}
+
+void
+default_interleave_buffer (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t stride)
+{
+	if (stride == 1) {
+		memcpy (dst, src, nframes * sizeof (ARDOUR::Sample));
+		return;
+	}
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i * stride] = src[i];
+	}
+}
+
+void
+default_deinterleave_buffer (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t stride)
+{
+	if (stride == 1) {
+		memcpy (dst, src, nframes * sizeof (ARDOUR::Sample));
+		return;
+	}
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] = src[i * stride];
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -187,6 +229,12 @@ veclib_mix_buffers_no_gain (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pf
 	vDSP_vsma(src, 1, &gain, dst, 1, dst, 1, nframes);
 }
 
+void
+veclib_apply_gain_vector_to_buffer (ARDOUR::Sample * buf, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	vDSP_vmul(buf, 1, gain, 1, buf, 1, nframes);
+}
+
 #endif
 
 
@@ -26,6 +26,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include <set>
 #include <stdint.h>
 #include <string>
@@ -349,8 +350,13 @@ Playlist::init (bool hide)
 	_frozen                     = false;
 	_capture_insertion_underway = false;
 	_combine_ops                = 0;
+	_region_index_valid         = false;
+	_region_index_writing       = false;
+	_region_state_cache         = 0;
+	_region_state_cache_gen     = 0;
 
 	_refcnt.store (0);
+	_region_state_gen.store (1);
 
 	_end_space = timecnt_t (_type == DataType::AUDIO ? Temporal::AudioTime : Temporal::BeatTime);
 	_playlist_shift_active = false;
@@ -373,6 +379,8 @@ Playlist::~Playlist ()
 		}
 	}
 
+	delete _region_state_cache;
+
 	/* GoingAway must be emitted by derived classes */
 }
 
@@ -1679,6 +1687,14 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, std::weak_pt
 		return;
 	}
 
+	/* invalidate caches before derived classes may ignore the change */
+
+	invalidate_region_state ();
+
+	if (what_changed.contains (Properties::length) || what_changed.contains (Properties::time_domain)) {
+		invalidate_region_index ();
+	}
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1811,6 +1827,125 @@ Playlist::deep_sources (std::set<std::shared_ptr<Source> >& sources) const
 	}
 }
 
+void
+Playlist::invalidate_region_index ()
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index.clear ();
+	_region_index_valid = false;
+}
+
+/* called by RegionWriteLock, the region-list is about to change or has changed */
+void
+Playlist::region_index_write (bool yn)
+{
+	invalidate_region_state ();
+
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index.clear ();
+	_region_index_valid   = false;
+	_region_index_writing = yn;
+}
+
+superclock_t
+Playlist::build_region_index (RegionIndex& idx, size_t lo, size_t hi)
+{
+	if (lo >= hi) {
+		return std::numeric_limits<superclock_t>::min ();
+	}
+	size_t const mid = lo + (hi - lo) / 2;
+	superclock_t const l = build_region_index (idx, lo, mid);
+	superclock_t const r = build_region_index (idx, mid + 1, hi);
+	idx[mid].max_last = std::max (idx[mid].last, std::max (l, r));
+	return idx[mid].max_last;
+}
+
+bool
+Playlist::update_region_index () const
+{
+	/* Caller must hold the region lock and _region_index_lock */
+
+	if (_region_index_writing || holding_state () || regions.size () < 64) {
+		/* regions may currently be modified, or the list is short */
+		return false;
+	}
+
+	/* positions in BeatTime depend on the tempo-map */
+	Temporal::TempoMap::SharedPtr tmap (Temporal::TempoMap::use ());
+
+	if (_region_index_valid && _region_index_tempo_map == tmap) {
+		return true;
+	}
+
+	_region_index.clear ();
+	_region_index.reserve (regions.size ());
+
+	for (auto const & r : regions) {
+		RegionIndexEntry e;
+		e.start    = r->position ().superclocks ();
+		e.last     = r->nt_last ().superclocks ();
+		e.max_last = e.last;
+		e.region   = r.get ();
+		_region_index.push_back (e);
+	}
+
+	std::stable_sort (_region_index.begin (), _region_index.end (), RegionIndexEntry::start_less);
+	build_region_index (_region_index, 0, _region_index.size ());
+
+	_region_index_tempo_map = tmap;
+	_region_index_valid     = true;
+
+	DEBUG_TRACE (DEBUG::Playlists, string_compose ("%1: rebuilt region index with %2 entries\n", name (), _region_index.size ()));
+	return true;
+}
+
+template <typename F> void
+Playlist::visit_region_index (size_t lo, size_t hi, superclock_t s, superclock_t e, F const & f) const
+{
+	while (lo < hi) {
+		size_t const            mid = lo + (hi - lo) / 2;
+		RegionIndexEntry const& n (_region_index[mid]);
+
+		if (n.max_last < s) {
+			/* nothing in this sub-tree reaches s */
+			return;
+		}
+
+		visit_region_index (lo, mid, s, e, f);
+
+		if (n.start > e) {
+			/* this and all later regions start after e */
+			return;
+		}
+		if (n.last >= s) {
+			f (n.region);
+		}
+		lo = mid + 1;
+	}
+}
+
+/** Call @a f for all regions that may overlap the range [start, end],
+ * in order of their position. This is a superset of the regions
+ * that actually overlap, @a f needs to perform the exact check.
+ * Caller must hold the region lock.
+ */
+template <typename F> void
+Playlist::foreach_region_in (timepos_t const & start, timepos_t const & end, F const & f) const
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (update_region_index ()) {
+		visit_region_index (0, _region_index.size (), start.superclocks (), end.superclocks (), f);
+		return;
+	}
+
+	lm.release ();
+
+	for (auto const & r : regions) {
+		f (r.get ());
+	}
+}
+
 std::shared_ptr<RegionList>
 Playlist::regions_at (timepos_t const & pos)
 {
@@ -1824,11 +1959,11 @@ Playlist::count_regions_at (timepos_t const & pos) const
 	RegionReadLock rlock (const_cast<Playlist*> (this));
 	uint32_t       cnt = 0;
 
-	for (auto const & r : regions) {
+	foreach_region_in (pos, pos, [&] (Region* r) {
 		if (r->covers (pos)) {
 			cnt++;
 		}
-	}
+	});
 
 	return cnt;
 }
@@ -1837,45 +1972,31 @@ std::shared_ptr<Region>
 Playlist::top_region_at (timepos_t const & pos)
 {
 	RegionReadLock rlock (this);
-	std::shared_ptr<RegionList> rlist = find_regions_at (pos);
-	std::shared_ptr<Region> region;
+	Region*        top = 0;
 
-	if (rlist->size ()) {
-		RegionSortByLayer cmp;
-		rlist->sort (cmp);
-		region = rlist->back ();
-	}
+	/* topmost layer, last one in case of equal layers */
+	foreach_region_in (pos, pos, [&] (Region* r) {
+		if (r->covers (pos) && (!top || r->layer () >= top->layer ())) {
+			top = r;
+		}
+	});
 
-	return region;
+	return top ? top->shared_from_this () : std::shared_ptr<Region> ();
 }
 
 std::shared_ptr<Region>
 Playlist::top_unmuted_region_at (timepos_t const & pos)
 {
 	RegionReadLock rlock (this);
-	std::shared_ptr<RegionList> rlist = find_regions_at (pos);
-
-	for (RegionList::iterator i = rlist->begin (); i != rlist->end ();) {
-		RegionList::iterator tmp = i;
+	Region*        top = 0;
 
-		++tmp;
-
-		if ((*i)->muted ()) {
-			rlist->erase (i);
+	foreach_region_in (pos, pos, [&] (Region* r) {
+		if (r->covers (pos) && !r->muted () && (!top || r->layer () >= top->layer ())) {
+			top = r;
 		}
+	});
 
-		i = tmp;
-	}
-
-	std::shared_ptr<Region> region;
-
-	if (rlist->size ()) {
-		RegionSortByLayer cmp;
-		rlist->sort (cmp);
-		region = rlist->back ();
-	}
-
-	return region;
+	return top ? top->shared_from_this () : std::shared_ptr<Region> ();
 }
 
 std::shared_ptr<RegionList>
@@ -1945,11 +2066,11 @@ Playlist::find_regions_at (timepos_t const & pos)
 
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
-	for (auto & r : regions) {
+	foreach_region_in (pos, pos, [&] (Region* r) {
 		if (r->covers (pos)) {
-			rlist->push_back (r);
+			rlist->push_back (r->shared_from_this ());
 		}
-	}
+	});
 
 	return rlist;
 }
@@ -1960,11 +2081,11 @@ Playlist::regions_with_start_within (Temporal::Range range)
 	RegionReadLock              rlock (this);
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
-	for (auto & r : regions) {
+	foreach_region_in (range.start(), range.end(), [&] (Region* r) {
 		if (r->position() >= range.start() && r->position() < range.end()) {
-			rlist->push_back (r);
+			rlist->push_back (r->shared_from_this ());
 		}
-	}
+	});
 
 	return rlist;
 }
@@ -1975,11 +2096,11 @@ Playlist::regions_with_end_within (Temporal::Range range)
 	RegionReadLock              rlock (this);
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
-	for (auto & r : regions) {
+	foreach_region_in (range.start(), range.end(), [&] (Region* r) {
 		if (r->nt_last() >= range.start() && r->nt_last() < range.end()) {
-			rlist->push_back (r);
+			rlist->push_back (r->shared_from_this ());
 		}
-	}
+	});
 
 	return rlist;
 }
@@ -1996,11 +2117,11 @@ Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end
 {
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
-	for (auto & r : regions) {
+	foreach_region_in (start, end, [&] (Region* r) {
 		if (r->coverage (start, end) != Temporal::OverlapNone) {
-			rlist->push_back (r);
+			rlist->push_back (r->shared_from_this ());
 		}
-	}
+	});
 
 	return rlist;
 }
@@ -2070,6 +2191,42 @@ Playlist::find_next_region (timepos_t const & pos, RegionPoint point, int dir)
 	std::shared_ptr<Region> ret;
 	timecnt_t closest = timecnt_t::max (pos.time_domain());
 
+	if (point == Start) {
+		/* the index is sorted by position */
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		if (update_region_index ()) {
+			superclock_t const sc = pos.superclocks ();
+			RegionIndexEntry   key;
+			key.start = sc;
+			if (dir == 1) {
+				/* first region that starts after pos */
+				RegionIndex::const_iterator i = std::lower_bound (_region_index.begin (), _region_index.end (), key, RegionIndexEntry::start_less);
+				for (; i != _region_index.end (); ++i) {
+					if (i->region->position () > pos) {
+						return i->region->shared_from_this ();
+					}
+				}
+			} else {
+				/* closest region that starts before pos, the first one of those at the same position */
+				RegionIndex::const_iterator i = std::upper_bound (_region_index.begin (), _region_index.end (), key, RegionIndexEntry::start_less);
+				Region* r = 0;
+				while (i != _region_index.begin ()) {
+					--i;
+					if (r && i->region->position () != r->position ()) {
+						break;
+					}
+					if (i->region->position () < pos) {
+						r = i->region;
+					}
+				}
+				if (r) {
+					ret = r->shared_from_this ();
+				}
+			}
+			return ret;
+		}
+	}
+
 	bool end_iter = false;
 
 	for (auto const & r : regions) {
@@ -2396,10 +2553,28 @@ Playlist::get_template ()
 	return state (false);
 }
 
+XMLNode&
+Playlist::get_state_cached () const
+{
+	return build_state (true, true);
+}
+
+void
+Playlist::invalidate_region_state ()
+{
+	_region_state_gen.fetch_add (1);
+}
+
 /** @param full_state true to include regions in the returned state, otherwise false.
  */
 XMLNode&
 Playlist::state (bool full_state) const
+{
+	return build_state (full_state, false);
+}
+
+XMLNode&
+Playlist::build_state (bool full_state, bool use_cache) const
 {
 	XMLNode* node = new XMLNode (X_("Playlist"));
 
@@ -2426,9 +2601,33 @@ Playlist::state (bool full_state) const
 
 		node->set_property ("combine-ops", _combine_ops);
 
-		for (auto const & r : regions) {
-			assert (r->sources ().size () > 0 && r->master_sources ().size () > 0);
-			node->add_child_nocopy (r->get_state ());
+		if (use_cache) {
+			/* The generation is read before serializing the regions.
+			 * A concurrent change will increment it once more, and
+			 * the cache is refreshed the next time.
+			 */
+			uint64_t const gen = _region_state_gen.load ();
+
+			Glib::Threads::Mutex::Lock lm (_region_state_cache_lock);
+
+			if (!_region_state_cache || _region_state_cache_gen != gen) {
+				delete _region_state_cache;
+				_region_state_cache = new XMLNode (X_("Regions"));
+				for (auto const & r : regions) {
+					assert (r->sources ().size () > 0 && r->master_sources ().size () > 0);
+					_region_state_cache->add_child_nocopy (r->get_state ());
+				}
+				_region_state_cache_gen = gen;
+			}
+
+			for (auto const & c : _region_state_cache->children ()) {
+				node->add_child_copy (*c);
+			}
+		} else {
+			for (auto const & r : regions) {
+				assert (r->sources ().size () > 0 && r->master_sources ().size () > 0);
+				node->add_child_nocopy (r->get_state ());
+			}
 		}
 	}
 
@@ -2604,6 +2803,9 @@ Playlist::relayer ()
 		return;
 	}
 
+	/* Region::set_layer() does not emit a property change */
+	invalidate_region_state ();
+
 	if (regions.empty()) {
 		/* nothing to do */
 		return;
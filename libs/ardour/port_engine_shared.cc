@@ -33,6 +33,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _connections (new ConnectionList)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -45,7 +46,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 BackendPort::~BackendPort ()
 {
 	_backend.port_connect_add_remove_callback (); // XXX -> RT
-	assert (_connections.empty());
+	assert (_connections.reader ()->empty ());
 }
 
 int
@@ -96,7 +97,9 @@ BackendPort::connect (BackendPortHandle port, BackendPortHandle self)
 void
 BackendPort::store_connection (BackendPortHandle port)
 {
-	_connections.insert (port);
+	RCUWriter<ConnectionList> writer (_connections);
+	std::shared_ptr<ConnectionList> cl = writer.get_copy ();
+	cl->insert (std::lower_bound (cl->begin (), cl->end (), port), port);
 }
 
 int
@@ -123,32 +126,56 @@ BackendPort::disconnect (BackendPortHandle port, BackendPortHandle self)
 
 void BackendPort::remove_connection (BackendPortHandle port)
 {
-	std::set<BackendPortPtr>::iterator it = _connections.find (port);
-	assert (it != _connections.end ());
-	_connections.erase (it);
+	RCUWriter<ConnectionList> writer (_connections);
+	std::shared_ptr<ConnectionList> cl = writer.get_copy ();
+	ConnectionList::iterator it = std::lower_bound (cl->begin (), cl->end (), port);
+	assert (it != cl->end () && *it == port);
+	cl->erase (it);
 }
 
 
 void BackendPort::disconnect_all (BackendPortHandle self)
 {
-	while (!_connections.empty ()) {
-		std::set<BackendPortPtr>::iterator it = _connections.begin ();
-		(*it)->remove_connection (self);
-		_backend.port_connect_callback (name(), (*it)->name(), false);
-		_connections.erase (it);
+	std::shared_ptr<ConnectionList const> cl = _connections.reader ();
+
+	for (auto const& port : *cl) {
+		port->remove_connection (self);
+		_backend.port_connect_callback (name(), port->name(), false);
+	}
+
+	{
+		RCUWriter<ConnectionList> writer (_connections);
+		writer.get_copy ()->clear ();
+	}
+
+	/* Old lists were moved to the dead wood, and reference this port
+	 * and its peers. Drop those that are no longer used, so that ports
+	 * which are unregistered do not keep each other alive. Lists that
+	 * the process thread still uses are kept, so that it never releases
+	 * the last reference to a port; they are dropped with the next
+	 * update of the peer's connections.
+	 */
+	std::vector<BackendPortPtr> peers (cl->begin (), cl->end ());
+	cl.reset ();
+
+	for (auto const& port : peers) {
+		port->_connections.cleanup ();
 	}
+	_connections.cleanup ();
 }
 
 bool
 BackendPort::is_connected (BackendPortHandle port) const
 {
-	return _connections.find (port) != _connections.end ();
+	std::shared_ptr<ConnectionList const> cl = _connections.reader ();
+	return std::binary_search (cl->begin (), cl->end (), port);
 }
 
 bool BackendPort::is_physically_connected () const
 {
-	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
-		if ((*it)->is_physical ()) {
+	std::shared_ptr<ConnectionList const> cl = _connections.reader ();
+	for (auto const& port : *cl) {
+		if (port->is_physical ()) {
 			return true;
 		}
 	}
@@ -166,9 +193,10 @@ BackendPort::set_latency_range (const LatencyRange &latency_range, bool for_play
 
 	lr = latency_range;
 
-	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
-		if ((*it)->is_physical ()) {
-			(*it)->update_connected_latency (is_input ());
+	std::shared_ptr<ConnectionList const> cl = _connections.reader ();
+	for (auto const& port : *cl) {
+		if (port->is_physical ()) {
+			port->update_connected_latency (is_input ());
 		}
 	}
 }
@@ -178,9 +206,10 @@ BackendPort::update_connected_latency (bool for_playback)
 {
 	LatencyRange lr;
 	lr.min = lr.max = 0;
-	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
+	std::shared_ptr<ConnectionList const> cl = _connections.reader ();
+	for (auto const& port : *cl) {
 		LatencyRange l;
-		l = (*it)->latency_range (for_playback);
+		l = port->latency_range (for_playback);
 		lr.min = std::max (lr.min, l.min);
 		lr.max = std::max (lr.max, l.max);
 	}
@@ -282,6 +311,43 @@ PortEngineSharedImpl::~PortEngineSharedImpl ()
 	pthread_mutex_destroy (&_port_callback_mutex);
 }
 
+void
+PortEngineSharedImpl::index_insert (PortIndex& ps, BackendPortHandle port)
+{
+	ps.insert (std::upper_bound (ps.begin (), ps.end (), port, SortByPortName ()), port);
+}
+
+bool
+PortEngineSharedImpl::index_erase (PortIndex& ps, BackendPortHandle port)
+{
+	std::pair<PortIndex::iterator, PortIndex::iterator> r = std::equal_range (ps.begin (), ps.end (), port, SortByPortName ());
+	PortIndex::iterator i = std::find (r.first, r.second, port);
+	if (i == r.second) {
+		/* not found by name, the name may have changed */
+		i = std::find (ps.begin (), ps.end (), port);
+		if (i == ps.end ()) {
+			return false;
+		}
+	}
+	ps.erase (i);
+	return true;
+}
+
+void
+PortEngineSharedImpl::registry_insert (PortRegistry& pr, BackendPortHandle port)
+{
+	pr.insert (std::lower_bound (pr.begin (), pr.end (), port), port);
+}
+
+void
+PortEngineSharedImpl::registry_erase (PortRegistry& pr, BackendPortHandle port)
+{
+	PortRegistry::iterator i = std::lower_bound (pr.begin (), pr.end (), port);
+	if (i != pr.end () && *i == port) {
+		pr.erase (i);
+	}
+}
+
 int
 PortEngineSharedImpl::get_ports (
 	const std::string& port_name_pattern,
@@ -420,8 +486,8 @@ PortEngineSharedImpl::add_port (const std::string& name, ARDOUR::DataType type,
 		std::shared_ptr<PortMap> pm      = map_writer.get_copy ();
 		std::shared_ptr<PortRegistry> pr = registry_writer.get_copy ();
 
-		ps->insert (port);
-		pr->insert (port);
+		index_insert (*ps, port);
+		registry_insert (*pr, port);
 		pm->insert (make_pair (name, port));
 	}
 
@@ -442,9 +508,7 @@ PortEngineSharedImpl::unregister_port (PortEngine::PortHandle port_handle)
 		std::shared_ptr<PortMap> pm      = map_writer.get_copy ();
 		std::shared_ptr<PortRegistry> pr = registry_writer.get_copy ();
 
-		PortIndex::iterator i = std::find (ps->begin(), ps->end(), std::dynamic_pointer_cast<BackendPort> (port_handle));
-
-		if (i == ps->end ()) {
+		if (!port || !index_erase (*ps, port)) {
 			PBD::error << string_compose (_("%1::unregister_port: Failed to find port: (%2)"), _instance_name, port ? port->name() : "(invalid)") << endmsg;
 			return;
 		}
@@ -452,8 +516,7 @@ PortEngineSharedImpl::unregister_port (PortEngine::PortHandle port_handle)
 		disconnect_all (port_handle);
 
 		pm->erase (port->name());
-		ps->erase (i);
-		pr->erase (port);
+		registry_erase (*pr, port);
 	}
 
 	_ports.flush ();
@@ -480,13 +543,14 @@ PortEngineSharedImpl::unregister_ports (bool system_only)
 		std::shared_ptr<PortRegistry> pr = registry_writer.get_copy ();
 
 		for (PortIndex::iterator i = ps->begin (); i != ps->end ();) {
-			PortIndex::iterator cur = i++;
-			BackendPortPtr port = *cur;
+			BackendPortPtr port = *i;
 			if (! system_only || (port->is_physical () && port->is_terminal ())) {
 				port->disconnect_all (port);
 				pm->erase (port->name());
-				ps->erase (cur);
-				pr->erase (port);
+				registry_erase (*pr, port);
+				i = ps->erase (i);
+			} else {
+				++i;
 			}
 		}
 	}
@@ -554,9 +618,8 @@ PortEngineSharedImpl::set_port_name (PortEngine::PortHandle port_handle, const s
 
 	const std::string old_name = port->name();
 
-	/* PortIndex std::set is sorted by name, using the name as key.
-	 * So name-changes need to update the set.
-	 * PortRegistry does not change
+	/* PortIndex is sorted by name, so name-changes need to
+	 * re-insert the port. PortRegistry does not change
 	 */
 	RCUWriter<PortIndex> index_writer (_ports);
 	RCUWriter<PortMap>   map_writer (_portmap);
@@ -564,9 +627,9 @@ PortEngineSharedImpl::set_port_name (PortEngine::PortHandle port_handle, const s
 	std::shared_ptr<PortIndex> ps = index_writer.get_copy ();
 	std::shared_ptr<PortMap>   pm = map_writer.get_copy ();
 
-	ps->erase (port);
+	index_erase (*ps, port);
 	int ret = port->set_name (newname);
-	ps->insert (port);
+	index_insert (*ps, port);
 
 	if (ret == 0) {
 		pm->erase (old_name);
@@ -802,10 +865,10 @@ PortEngineSharedImpl::get_connections (PortEngine::PortHandle port_handle, std::
 
 	assert (0 == names.size ());
 
-	const std::set<BackendPortPtr>& connected_ports = port->get_connections ();
+	std::shared_ptr<BackendPort::ConnectionList const> connected_ports = port->get_connections ();
 
-	for (std::set<BackendPortPtr>::const_iterator i = connected_ports.begin (); i != connected_ports.end (); ++i) {
-		names.push_back ((*i)->name ());
+	for (auto const& p : *connected_ports) {
+		names.push_back (p->name ());
 	}
 
 	return (int)names.size ();
@@ -1292,10 +1292,12 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
 		for (auto const& p : *_cycle_ports) {
 			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (boost::bind (&Port::cycle_start, p.second, nframes));
+				Port* port = p.second.get ();
+				tl->push_back ([port, nframes] () { port->cycle_start (nframes); });
 			}
 		}
-		tl->push_back (boost::bind (&PortManager::run_input_meters, this, nframes, s ? s->nominal_sample_rate () : 0));
+		samplecnt_t const sr = s ? s->nominal_sample_rate () : 0;
+		tl->push_back ([this, nframes, sr] () { run_input_meters (nframes, sr); });
 		tl->process ();
 	} else {
 		for (auto const& p : *_cycle_ports) {
@@ -1318,7 +1320,8 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
 		for (auto const& p : *_cycle_ports) {
 			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (boost::bind (&Port::cycle_end, p.second, nframes));
+				Port* port = p.second.get ();
+				tl->push_back ([port, nframes] () { port->cycle_end (nframes); });
 			}
 		}
 		tl->process ();
@@ -1436,7 +1439,8 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
 		for (auto const& p : *_cycle_ports) {
 			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (boost::bind (&Port::cycle_end, p.second, nframes));
+				Port* port = p.second.get ();
+				tl->push_back ([port, nframes] () { port->cycle_end (nframes); });
 			}
 		}
 		tl->process ();
@@ -21,15 +21,11 @@
 
 using namespace ARDOUR;
 
-RTTask::RTTask (Graph* g, boost::function<void ()> const& fn)
-	: _f (fn)
-	, _graph (g)
-{
-}
-
 void
-RTTask::run (GraphChain const*)
+RTTaskChunk::run (GraphChain const*)
 {
-	_f ();
+	for (RTTask* t = _begin; t != _end; ++t) {
+		(*t) ();
+	}
 	_graph->reached_terminal_node ();
 }
@@ -16,32 +16,66 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cassert>
+
 #include "ardour/graph.h"
 #include "ardour/rt_tasklist.h"
 
 using namespace ARDOUR;
 
-RTTaskList::RTTaskList (std::shared_ptr<Graph> process_graph)
+RTTaskList::RTTaskList (std::shared_ptr<Graph> process_graph, size_t capacity)
 	: _graph (process_graph)
+	, _capacity (capacity)
+	, _max_chunks (256)
+	, _n_tasks (0)
+	, _n_chunks (0)
 {
-	_tasks.reserve (256);
+	_tasks  = new RTTask[_capacity];
+	_chunks = new RTTaskChunk[_max_chunks];
 }
 
-void
-RTTaskList::push_back (boost::function<void ()> fn)
+RTTaskList::~RTTaskList ()
 {
-	_tasks.push_back (RTTask (_graph.get(), fn));
+	delete[] _chunks;
+	delete[] _tasks;
 }
 
 void
 RTTaskList::process ()
 {
-	if (_graph->n_threads () > 1 && _tasks.size () > 2) {
+	uint32_t const n_threads = _graph->n_threads ();
+
+	if (n_threads > 1 && _n_tasks > 2) {
+		/* Hand out contiguous ranges of tasks rather than single tasks,
+		 * to reduce per-task synchronization overhead. Use a few chunks
+		 * per thread, so that threads which finish early can pick up
+		 * remaining work.
+		 */
+		size_t const n_chunks  = std::min (_n_tasks, std::min ((size_t) n_threads * 4, _max_chunks));
+		size_t const per_chunk = _n_tasks / n_chunks;
+		size_t const remainder = _n_tasks % n_chunks;
+
+		RTTask* t = _tasks;
+		for (size_t i = 0; i < n_chunks; ++i) {
+			_chunks[i]._graph = _graph.get ();
+			_chunks[i]._begin = t;
+			t += per_chunk + (i < remainder ? 1 : 0);
+			_chunks[i]._end = t;
+		}
+		assert (t == _tasks + _n_tasks);
+
+		_n_chunks = n_chunks;
 		_graph->process_tasklist (*this);
+		_n_chunks = 0;
 	} else {
-		for (auto const& fn : _tasks) {
-			fn._f ();
+		for (size_t i = 0; i < _n_tasks; ++i) {
+			_tasks[i] ();
 		}
 	}
-	_tasks.clear ();
+
+	for (size_t i = 0; i < _n_tasks; ++i) {
+		_tasks[i].reset ();
+	}
+	_n_tasks = 0;
 }
@@ -166,6 +166,7 @@ bool Session::_bypass_all_loaded_plugins = false;
 std::atomic<unsigned int> Session::_name_id_counter (0);
 
 PBD::Signal1<void,std::string> Session::Dialog;
+PBD::Signal1<void,std::string> Session::LoadPhase;
 PBD::Signal0<int> Session::AskAboutPendingState;
 PBD::Signal2<int, samplecnt_t, samplecnt_t> Session::AskAboutSampleRateMismatch;
 PBD::Signal2<void, samplecnt_t, samplecnt_t> Session::NotifyAboutSampleRateMismatch;
@@ -252,6 +253,8 @@ Session::Session (AudioEngine &eng,
 	, _state_of_the_state (StateOfTheState (CannotSave | InitialConnecting | Loading))
 	, _save_queued (false)
 	, _save_queued_pending (false)
+	, _save_thread (0)
+	, _save_cached_state (false)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
@@ -357,6 +360,8 @@ Session::Session (AudioEngine &eng,
 	_have_rec_enabled_track.store (0);
 	_have_rec_disabled_track.store (1);
 	_latency_recompute_pending.store (0);
+	_graph_rank_pending.store (0);
+	_graph_rank_countdown = 0;
 	_suspend_timecode_transmission.store (0);
 	_update_pretty_names.store (0);
 	_seek_counter.store (0);
@@ -437,6 +442,8 @@ Session::Session (AudioEngine &eng,
 
 	} else {
 
+		LoadPhase (X_("read session file"));
+
 		if (load_state (_current_snapshot_name)) {
 			destroy ();
 			throw SessionException (_("Failed to load state"));
@@ -2579,6 +2586,9 @@ Session::rechain_process_graph (GraphNodeList& g)
 			 * be helf by the process-callback. So we delegate deletion to the butler thread.
 			 */
 			_graph_chain = std::shared_ptr<GraphChain> (new GraphChain (g, edges), boost::bind (&rt_safe_delete<GraphChain>, this, _1));
+			/* size the graph's queues for the new chain */
+			_graph_rank_pending.store (1);
+			auto_connect_thread_wakeup ();
 		} else {
 			_graph_chain.reset ();
 		}
@@ -2591,6 +2601,41 @@ Session::rechain_process_graph (GraphNodeList& g)
 	return false;
 }
 
+/** Called from the auto-connect thread, to size the process graph's
+ * queues for new chains, and to order the graph chains by the DSP cost
+ * that was measured since they were built.
+ */
+void
+Session::rank_process_graph ()
+{
+	size_t n_nodes = 0;
+
+	std::shared_ptr<GraphChain> gc (_graph_chain);
+	if (gc) {
+		n_nodes = gc->_nodes_rt.size ();
+	}
+	for (int i = 0; i < 2; ++i) {
+		std::shared_ptr<GraphChain> io (_io_graph_chain[i]);
+		if (io) {
+			n_nodes = std::max (n_nodes, io->_nodes_rt.size ());
+		}
+	}
+
+	if (_process_graph) {
+		_process_graph->reserve_queues (n_nodes);
+	}
+
+	if (gc) {
+		gc->rank ();
+	}
+	for (int i = 0; i < 2; ++i) {
+		std::shared_ptr<GraphChain> io (_io_graph_chain[i]);
+		if (io) {
+			io->rank ();
+		}
+	}
+}
+
 bool
 Session::rechain_ioplug_graph (bool pre)
 {
@@ -2612,6 +2657,8 @@ Session::rechain_ioplug_graph (bool pre)
 
 	if (topological_sort (gnl, edges)) {
 		_io_graph_chain[pre ? 0 : 1] = std::shared_ptr<GraphChain> (new GraphChain (gnl, edges), boost::bind (&rt_safe_delete<GraphChain>, this, _1));
+		_graph_rank_pending.store (1);
+		auto_connect_thread_wakeup ();
 		return true;
 	}
 	return false;
@@ -6619,6 +6666,24 @@ Session::plot_process_graph (std::string const& file_name) const {
 	return _graph_chain ? _graph_chain->plot (file_name) : false;
 }
 
+GraphSchedulerStats
+Session::process_graph_scheduler_stats () const
+{
+	return _process_graph->scheduler_stats ();
+}
+
+bool
+Session::process_graph_critical_path (double& critical_path, double& total_cost) const
+{
+	std::shared_ptr<GraphChain> gc (_graph_chain);
+	if (!gc) {
+		return false;
+	}
+	critical_path = gc->critical_path ();
+	total_cost    = gc->total_cost ();
+	return true;
+}
+
 void
 Session::add_automation_list(AutomationList *al)
 {
@@ -7892,6 +7957,10 @@ Session::auto_connect_thread_run ()
 			}
 		}
 
+		if (_graph_rank_pending.fetch_and (0)) {
+			rank_process_graph ();
+		}
+
 		if (_midi_ports && _update_pretty_names.load ()) {
 			std::shared_ptr<Port> ap = std::dynamic_pointer_cast<Port> (vkbd_output_port ());
 			if (ap->pretty_name () != _("Virtual Keyboard")) {
@@ -423,7 +423,7 @@ get_id_sorted_playlists (const PlaylistSet& playlists, IDSortedList& id_sorted_p
 } // anonymous namespace
 
 void
-SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unused) const
+SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unused, bool cached) const
 {
 	XMLNode* child = node->add_child ("Playlists");
 
@@ -434,6 +434,8 @@ SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unu
 		if (!(*i)->hidden ()) {
 			if (save_template) {
 				child->add_child_nocopy ((*i)->get_template ());
+			} else if (cached) {
+				child->add_child_nocopy ((*i)->get_state_cached ());
 			} else {
 				child->add_child_nocopy ((*i)->get_state ());
 			}
@@ -455,6 +457,8 @@ SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unu
 			if (!(*i)->empty()) {
 				if (save_template) {
 					child->add_child_nocopy ((*i)->get_template());
+				} else if (cached) {
+					child->add_child_nocopy ((*i)->get_state_cached ());
 				} else {
 					child->add_child_nocopy ((*i)->get_state());
 				}
@@ -145,6 +145,16 @@ Session::process (pframes_t nframes)
 		}
 	}
 
+	/* About once a second, let the auto-connect thread re-rank the
+	 * process graph using the DSP cost measured during past cycles.
+	 */
+	_graph_rank_countdown -= nframes;
+	if (_graph_rank_countdown <= 0) {
+		_graph_rank_countdown = nominal_sample_rate ();
+		_graph_rank_pending.store (1);
+		auto_connect_thread_wakeup ();
+	}
+
 	if (_update_send_delaylines) {
 		std::shared_ptr<RouteList const> r = routes.reader ();
 		for (auto const& i : *r) {
@@ -761,17 +771,14 @@ Session::process_audition (pframes_t nframes)
 	SessionEvent* ev;
 	std::shared_ptr<RouteList const> r = routes.reader ();
 
-	std::shared_ptr<GraphChain> graph_chain = _graph_chain;
-	if (graph_chain) {
-		/* Ideally we'd use Session::rt_tasklist, since dependency is irrelevant. */
-		_process_graph->silence_routes (graph_chain, nframes);
-	} else {
-		for (auto const& i : *r) {
-			if (!i->is_auditioner()) {
-				i->silence (nframes);
-			}
+	/* dependencies are irrelevant for silence, no need to use the graph-chain */
+	for (auto const& i : *r) {
+		if (!i->is_auditioner()) {
+			Route* route = i.get ();
+			_rt_tasklist->push_back ([route, nframes] () { route->silence (nframes); });
 		}
 	}
+	_rt_tasklist->process ();
 
 	/* handle pending events */
 
@@ -280,6 +280,7 @@ Session::post_engine_init ()
 		 */
 
 		if (state_tree) {
+			LoadPhase (X_("restore state"));
 			try {
 				switch (set_state (*state_tree->root(), Stateful::loading_state_version)) {
 					case 0:
@@ -315,6 +316,7 @@ Session::post_engine_init ()
 		 * engine is running, ports are re-established,
 		 * and IOChange are complete.
 		 */
+		LoadPhase (X_("configure processors"));
 		{
 			Glib::Threads::Mutex::Lock lx (AudioEngine::instance()->process_lock ());
 			ProcessorChangeBlocker pcb (this);
@@ -349,6 +351,7 @@ Session::post_engine_init ()
 		 * it will try to make connections whose details are loaded by set_port_states.
 		 */
 
+		LoadPhase (X_("connect ports"));
 		hookup_io ();
 
 		/* Let control protocols know that we are now all connected, so they
@@ -673,12 +676,21 @@ void
 Session::maybe_write_autosave()
 {
 	if (dirty() && record_status() != Recording) {
-		save_state("", true);
+		save_state_async ();
 	}
 }
 
 void
 Session::remove_pending_capture_state ()
+{
+	/* a background save may be about to (re-)create the file */
+	Glib::Threads::Mutex::Lock lm (save_state_lock);
+	wait_for_background_save ();
+	remove_pending_state_file ();
+}
+
+void
+Session::remove_pending_state_file ()
 {
 	std::string pending_state_file_path(_session_dir->root_path());
 
@@ -783,6 +795,8 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		return 1;
 	}
 
+	wait_for_background_save ();
+
 	if (_suspend_save.load ()) {
 		/* StateProtector cannot be used for templates or save-as */
 		assert (!template_only && !switch_to_snapshot && !for_archive && (snapshot_name.empty () || snapshot_name == _current_snapshot_name));
@@ -865,29 +879,8 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name) + temp_suffix);
 
-	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
-
-	if (!tree.write (tmp_path)) {
-		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
-		if (g_remove (tmp_path.c_str()) != 0) {
-			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-					tmp_path, g_strerror (errno)) << endmsg;
-		}
+	if (write_state_file (tree, tmp_path, xml_path)) {
 		return -1;
-
-	} else {
-
-		DEBUG_TRACE (DEBUG::SaveState, string_compose ("renaming state to '%1'\n", xml_path));
-
-		if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
-			error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
-					tmp_path, xml_path, g_strerror(errno)) << endmsg;
-			if (g_remove (tmp_path.c_str()) != 0) {
-				error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-						tmp_path, g_strerror (errno)) << endmsg;
-			}
-			return -1;
-		}
 	}
 
 	//Mixbus auto-backup mechanism
@@ -896,18 +889,7 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 			// make a serialized safety backup
 			// (will make one periodically but only one per hour is left on disk)
 			// these backup files go into a separated folder
-			char timebuf[128];
-			time_t n;
-			struct tm local_time;
-			time (&n);
-			localtime_r (&n, &local_time);
-			strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
-			std::string save_path(session_directory().backup_path());
-			save_path += G_DIR_SEPARATOR;
-			save_path += legalize_for_path(_current_snapshot_name);
-			save_path += "-";
-			save_path += timebuf;
-			save_path += statefile_suffix;
+			std::string save_path (pending_backup_path ());
 			if (!copy_file (xml_path, save_path)) {
 					error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
 							save_path, g_strerror (errno)) << endmsg;
@@ -934,12 +916,148 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 #endif
 
 	if (!pending && !for_archive && ! template_only) {
-		remove_pending_capture_state ();
+		/* save_state_lock is held, background saves were waited for above */
+		remove_pending_state_file ();
+	}
+
+	return 0;
+}
+
+int
+Session::write_state_file (XMLTree& tree, std::string const& tmp_path, std::string const& xml_path)
+{
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
+
+	if (!tree.write (tmp_path)) {
+		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
+	}
+
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("renaming state to '%1'\n", xml_path));
+
+	if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
+		error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
+				tmp_path, xml_path, g_strerror(errno)) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
 	}
 
 	return 0;
 }
 
+std::string
+Session::pending_backup_path () const
+{
+	char timebuf[128];
+	time_t n;
+	struct tm local_time;
+	time (&n);
+	localtime_r (&n, &local_time);
+	strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
+	std::string save_path(session_directory().backup_path());
+	save_path += G_DIR_SEPARATOR;
+	save_path += legalize_for_path(_current_snapshot_name);
+	save_path += "-";
+	save_path += timebuf;
+	save_path += statefile_suffix;
+	return save_path;
+}
+
+int
+Session::save_state_async ()
+{
+	Glib::Threads::Mutex::Lock lm (save_state_lock);
+	Glib::Threads::Mutex::Lock lx (save_source_lock);
+
+	if (!_writable || cannot_save()) {
+		return 1;
+	}
+
+	/* only one save may be in flight */
+	wait_for_background_save ();
+
+	if (_suspend_save.load ()) {
+		_save_queued_pending = true;
+		return 1;
+	}
+	_save_queued_pending = false;
+
+#ifndef NDEBUG
+	const int64_t save_start_time = g_get_monotonic_time();
+#endif
+
+	for (SourceMap::const_iterator i = sources.begin(); i != sources.end(); ++i) {
+		try {
+			i->second->session_saved();
+		} catch (Evoral::SMF::FileError& e) {
+			error << string_compose ("Could not write to MIDI file %1; MIDI data not saved.", e.file_name ()) << endmsg;
+		}
+	}
+
+	SessionSaveUnderway (); /* EMIT SIGNAL */
+
+	/* Collecting state is not thread-safe, and has to happen here.
+	 * Playlists re-use region state of the previous save, if possible.
+	 */
+	XMLTree* tree = new XMLTree;
+	{
+		PBD::Unwinder<bool> uw (_save_cached_state, true);
+		tree->set_root (&state (false));
+	}
+
+	std::string const root_path (_session_dir->root_path());
+	std::string const xml_path (Glib::build_filename (root_path, legalize_for_path (_current_snapshot_name) + pending_suffix));
+	std::string const tmp_path (Glib::build_filename (root_path, legalize_for_path (_current_snapshot_name) + temp_suffix));
+	std::string const backup_path (Profile->get_mixbus() ? pending_backup_path () : "");
+
+#ifndef NDEBUG
+	if (DEBUG_ENABLED (DEBUG::SaveState)) {
+		const int64_t elapsed_time_us = g_get_monotonic_time() - save_start_time;
+		DEBUG_TRACE (DEBUG::SaveState, string_compose ("collected state in %1%2%3 ms\n", fixed, setprecision (1), elapsed_time_us / 1000.));
+	}
+#endif
+
+	_save_thread = PBD::Thread::create (boost::bind (&Session::background_save, this, tree, tmp_path, xml_path, backup_path), "SaveState");
+
+	if (!_save_thread) {
+		/* fall back to writing it here */
+		background_save (tree, tmp_path, xml_path, backup_path);
+	}
+
+	return 0;
+}
+
+void
+Session::background_save (XMLTree* tree, std::string tmp_path, std::string xml_path, std::string backup_path)
+{
+	if (write_state_file (*tree, tmp_path, xml_path) == 0 && !backup_path.empty ()) {
+		if (!copy_file (xml_path, backup_path)) {
+			error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
+					backup_path, g_strerror (errno)) << endmsg;
+		}
+	}
+	delete tree;
+}
+
+/* must be called with save_state_lock held */
+void
+Session::wait_for_background_save ()
+{
+	if (!_save_thread) {
+		return;
+	}
+	_save_thread->join ();
+	delete _save_thread;
+	_save_thread = 0;
+}
+
 int
 Session::restore_state (string snapshot_name)
 {
@@ -1527,7 +1645,7 @@ Session::state (bool save_template, snapshot_t snapshot_type, bool for_archive,
 		}
 	}
 
-	_playlists->add_state (node, save_template, !only_used_assets);
+	_playlists->add_state (node, save_template, !only_used_assets, _save_cached_state);
 
 	child = node->add_child ("RouteGroups");
 	for (list<RouteGroup *>::const_iterator i = _route_groups.begin(); i != _route_groups.end(); ++i) {
@@ -1854,6 +1972,8 @@ Session::set_state (const XMLNode& node, int version)
 		_speakers->set_state (*child, version);
 	}
 
+	LoadPhase (X_("sources"));
+
 	if ((child = find_named_node (node, "Sources")) == 0) {
 		error << _("Session: XML state has no 'Sources' section") << endmsg;
 		goto out;
@@ -1862,6 +1982,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	LoadPhase (X_("locations"));
+
 	if ((child = find_named_node (node, "Locations")) == 0) {
 		error << _("Session: XML state has no 'Locations' section") << endmsg;
 		goto out;
@@ -1876,6 +1998,8 @@ Session::set_state (const XMLNode& node, int version)
 		AudioFileSource::set_header_position_offset (_session_range_location->start().samples());
 	}
 
+	LoadPhase (X_("regions"));
+
 	if ((child = find_named_node (node, "Regions")) == 0) {
 		error << _("Session: XML state has no 'Regions' section") << endmsg;
 		goto out;
@@ -1884,6 +2008,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	LoadPhase (X_("playlists"));
+
 	if ((child = find_named_node (node, "Playlists")) == 0) {
 		error << _("Session: XML state has no 'Playlists' section") << endmsg;
 		goto out;
@@ -1985,6 +2111,8 @@ Session::set_state (const XMLNode& node, int version)
 		}
 	}
 
+	LoadPhase (X_("routes"));
+
 	if ((child = find_named_node (node, "Routes")) == 0) {
 		error << _("Session: XML state has no 'Routes' section") << endmsg;
 		goto out;
@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2026 Ardour Community
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef PLATFORM_WINDOWS
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+
+#include "ardour/debug.h"
+#include "ardour/smf_model_cache.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+#define SMF_MODEL_CACHE_VERSION 1
+
+/* All fields are naturally aligned, events follow the header.
+ * Each event is an EventHeader followed by the event data,
+ * padded to a multiple of 8 bytes.
+ */
+struct SMFModelCache::Header {
+	char     magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	int64_t  smf_size;
+	int64_t  smf_mtime;
+	uint64_t n_note_on_events;
+	int64_t  length;
+	uint64_t data_size;
+	uint32_t used_channels;
+	uint32_t has_pgm_change;
+};
+
+namespace {
+	struct EventHeader {
+		int64_t  time;
+		int32_t  id;
+		uint32_t size;
+	};
+
+	const char     cache_magic[8] = { 'A', 'S', 'M', 'F', 'C', 'A', 'C', 'H' };
+	const uint32_t cache_byte_order = 0x01020304;
+
+	inline size_t padded (size_t n) {
+		return (n + 7) & ~((size_t) 7);
+	}
+}
+
+SMFModelCache::SMFModelCache (std::string const& smf_path)
+	: _smf_path (smf_path)
+	, _map_addr (0)
+	, _map_length (0)
+	, _read_offset (0)
+	, _fd (-1)
+{
+}
+
+SMFModelCache::~SMFModelCache ()
+{
+	close ();
+}
+
+std::string
+SMFModelCache::cache_path (std::string const& smf_path)
+{
+	return Glib::build_filename (Glib::path_get_dirname (smf_path), "." + Glib::path_get_basename (smf_path) + ".cache");
+}
+
+void
+SMFModelCache::remove (std::string const& smf_path)
+{
+	::g_unlink (cache_path (smf_path).c_str ());
+}
+
+bool
+SMFModelCache::stat_smf (int64_t& size, int64_t& mtime) const
+{
+	GStatBuf statbuf;
+	if (g_stat (_smf_path.c_str (), &statbuf) != 0) {
+		return false;
+	}
+	size  = statbuf.st_size;
+	mtime = statbuf.st_mtime;
+	return true;
+}
+
+bool
+SMFModelCache::open ()
+{
+	close ();
+
+	int64_t smf_size;
+	int64_t smf_mtime;
+	if (!stat_smf (smf_size, smf_mtime)) {
+		return false;
+	}
+
+	std::string const path (cache_path (_smf_path));
+
+	GStatBuf statbuf;
+	if (g_stat (path.c_str (), &statbuf) != 0 || (size_t) statbuf.st_size < sizeof (Header)) {
+		return false;
+	}
+
+	_fd = g_open (path.c_str (), O_RDONLY, 0444);
+	if (_fd == -1) {
+		return false;
+	}
+	_map_length = statbuf.st_size;
+
+#ifdef PLATFORM_WINDOWS
+	HANDLE file_handle = (HANDLE) _get_osfhandle (int (_fd));
+	HANDLE map_handle  = CreateFileMapping (file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (map_handle != NULL) {
+		_map_addr = (uint8_t const*) MapViewOfFile (map_handle, FILE_MAP_READ, 0, 0, _map_length);
+		CloseHandle (map_handle);
+	}
+	if (!_map_addr) {
+		close ();
+		return false;
+	}
+#else
+	void* addr = mmap (NULL, _map_length, PROT_READ, MAP_PRIVATE, _fd, 0);
+	if (addr == MAP_FAILED) {
+		close ();
+		return false;
+	}
+	_map_addr = (uint8_t const*) addr;
+#endif
+
+	Header const* h = (Header const*) _map_addr;
+
+	if (memcmp (h->magic, cache_magic, sizeof (cache_magic))
+	    || h->version != SMF_MODEL_CACHE_VERSION
+	    || h->byte_order != cache_byte_order
+	    || h->smf_size != smf_size
+	    || h->smf_mtime != smf_mtime
+	    || h->data_size != _map_length - sizeof (Header)) {
+		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF model cache for %1 is stale\n", _smf_path));
+		close ();
+		return false;
+	}
+
+	_read_offset = sizeof (Header);
+	return true;
+}
+
+void
+SMFModelCache::close ()
+{
+	if (_map_addr) {
+#ifdef PLATFORM_WINDOWS
+		UnmapViewOfFile (_map_addr);
+#else
+		munmap (const_cast<uint8_t*> (_map_addr), _map_length);
+#endif
+	}
+	if (_fd != -1) {
+		::close (_fd);
+	}
+	_map_addr    = 0;
+	_map_length  = 0;
+	_read_offset = 0;
+	_fd          = -1;
+}
+
+uint64_t
+SMFModelCache::n_note_on_events () const
+{
+	assert (_map_addr);
+	return ((Header const*) _map_addr)->n_note_on_events;
+}
+
+bool
+SMFModelCache::has_pgm_change () const
+{
+	assert (_map_addr);
+	return ((Header const*) _map_addr)->has_pgm_change != 0;
+}
+
+Evoral::SMF::UsedChannels
+SMFModelCache::used_channels () const
+{
+	assert (_map_addr);
+	return Evoral::SMF::UsedChannels (((Header const*) _map_addr)->used_channels);
+}
+
+Temporal::Beats
+SMFModelCache::length () const
+{
+	assert (_map_addr);
+	return Temporal::Beats::ticks (((Header const*) _map_addr)->length);
+}
+
+bool
+SMFModelCache::next_event (Temporal::Beats& time, Evoral::event_id_t& id, uint32_t& size, uint8_t const*& buf)
+{
+	assert (_map_addr);
+
+	if (_read_offset + sizeof (EventHeader) > _map_length) {
+		return false;
+	}
+
+	EventHeader const* e = (EventHeader const*) &_map_addr[_read_offset];
+
+	if (_read_offset + sizeof (EventHeader) + e->size > _map_length) {
+		/* truncated */
+		return false;
+	}
+
+	time = Temporal::Beats::ticks (e->time);
+	id   = e->id;
+	size = e->size;
+	buf  = &_map_addr[_read_offset + sizeof (EventHeader)];
+
+	_read_offset += sizeof (EventHeader) + padded (e->size);
+	return true;
+}
+
+void
+SMFModelCache::add_event (Temporal::Beats const& time, Evoral::event_id_t id, uint32_t size, uint8_t const* buf)
+{
+	EventHeader e;
+	e.time = time.to_ticks ();
+	e.id   = id;
+	e.size = size;
+
+	size_t const off = _data.size ();
+	_data.resize (off + sizeof (EventHeader) + padded (size), 0);
+	memcpy (&_data[off], &e, sizeof (EventHeader));
+	memcpy (&_data[off + sizeof (EventHeader)], buf, size);
+}
+
+int
+SMFModelCache::write (uint64_t n_note_on_events, bool has_pgm_change, Evoral::SMF::UsedChannels const& used_channels, Temporal::Beats const& length)
+{
+	Header h;
+	memset (&h, 0, sizeof (Header));
+
+	if (!stat_smf (h.smf_size, h.smf_mtime)) {
+		return -1;
+	}
+
+	memcpy (h.magic, cache_magic, sizeof (cache_magic));
+	h.version          = SMF_MODEL_CACHE_VERSION;
+	h.byte_order       = cache_byte_order;
+	h.n_note_on_events = n_note_on_events;
+	h.length           = length.to_ticks ();
+	h.data_size        = _data.size ();
+	h.used_channels    = used_channels.to_ulong ();
+	h.has_pgm_change   = has_pgm_change ? 1 : 0;
+
+	/* write to a temporary file, and atomically replace the cache */
+	std::string const path (cache_path (_smf_path));
+	std::string const tmp (path + ".tmp");
+
+	FILE* f = g_fopen (tmp.c_str (), "wb");
+	if (!f) {
+		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("Cannot write SMF model cache %1\n", tmp));
+		return -1;
+	}
+
+	bool ok = fwrite (&h, sizeof (Header), 1, f) == 1;
+	if (ok && !_data.empty ()) {
+		ok = fwrite (&_data[0], _data.size (), 1, f) == 1;
+	}
+	ok = (fclose (f) == 0) && ok;
+
+#ifdef PLATFORM_WINDOWS
+	/* rename does not replace an existing file on Windows */
+	if (ok) {
+		::g_unlink (path.c_str ());
+	}
+#endif
+
+	if (!ok || ::g_rename (tmp.c_str (), path.c_str ()) != 0) {
+		::g_unlink (tmp.c_str ());
+		warning << string_compose (_("Could not write MIDI model cache \"%1\""), path) << endmsg;
+		return -1;
+	}
+
+	_data.clear ();
+	return 0;
+}
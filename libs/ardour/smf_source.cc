@@ -52,6 +52,7 @@
 #include "ardour/midi_state_tracker.h"
 #include "ardour/parameter_types.h"
 #include "ardour/session.h"
+#include "ardour/smf_model_cache.h"
 #include "ardour/smf_source.h"
 
 #include "pbd/i18n.h"
@@ -194,6 +195,7 @@ SMFSource::~SMFSource ()
 {
 	if (removable()) {
 		::g_unlink (_path.c_str());
+		SMFModelCache::remove (_path);
 	}
 }
 
@@ -585,6 +587,9 @@ SMFSource::mark_midi_streaming_write_completed (const WriterLock& lm, Evoral::Se
 		_model->set_edited(false);
 	}
 
+	/* the file's mtime may not change when written within the same second */
+	SMFModelCache::remove (_path);
+
 	try {
 		Evoral::SMF::end_write (_path);
 	} catch (std::exception & e) {
@@ -659,6 +664,11 @@ SMFSource::load_model_unlocked (bool force_reload)
 	}
 
 	_model->start_write();
+
+	if (load_model_from_cache ()) {
+		return;
+	}
+
 	Evoral::SMF::seek_to_start();
 
 	uint64_t time = 0; /* in SMF ticks */
@@ -736,11 +746,11 @@ SMFSource::load_model_unlocked (bool force_reload)
 							delta_t, time, size, ss, event_id, name()));
 #endif
 
-				eventlist.push_back(make_pair (
-							new Evoral::Event<Temporal::Beats> (
-								Evoral::MIDI_EVENT, event_time,
-								size, buf, true)
-							, event_id));
+				Evoral::Event<Temporal::Beats>* e = new Evoral::Event<Temporal::Beats> (Evoral::MIDI_EVENT, event_time, size, buf, true);
+				if (have_event_id) {
+					e->set_id (event_id);
+				}
+				eventlist.push_back (make_pair (e, event_id));
 
 				// Set size to max capacity to minimize allocs in read_event
 				scratch_size = std::max(size, scratch_size);
@@ -759,12 +769,20 @@ SMFSource::load_model_unlocked (bool force_reload)
 
 	eventlist.sort(compare_eventlist);
 
+	SMFModelCache cache (_path);
+
 	std::list< std::pair< Evoral::Event<Temporal::Beats>*, gint > >::iterator it;
 	for (it=eventlist.begin(); it!=eventlist.end(); ++it) {
 		_model->append (*it->first, it->second);
+		/* the event's own ID is only set if it was stored in the file */
+		cache.add_event (it->first->time(), it->first->id(), it->first->size(), it->first->buffer());
 		delete it->first;
 	}
 
+	if (!eventlist.empty ()) {
+		cache.write (_n_note_on_events, _has_pgm_change, _used_channels, _length.beats());
+	}
+
         // cerr << "----SMF-SRC-----\n";
         // _playback_buf->dump (cerr);
         // cerr << "----------------\n";
@@ -775,6 +793,45 @@ SMFSource::load_model_unlocked (bool force_reload)
 	free (buf);
 }
 
+/** Build the model from the SMFModelCache, if it is valid for the file.
+ * The caller has to call start_write () on the model.
+ */
+bool
+SMFSource::load_model_from_cache ()
+{
+	SMFModelCache cache (_path);
+
+	if (!cache.open ()) {
+		return false;
+	}
+
+	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF %1 load model from cache\n", name()));
+
+	_n_note_on_events = cache.n_note_on_events ();
+	_has_pgm_change   = cache.has_pgm_change ();
+	_used_channels    = cache.used_channels ();
+	_num_channels     = _used_channels.size ();
+
+	Temporal::Beats    time;
+	Evoral::event_id_t id;
+	uint32_t           size;
+	uint8_t const*     buf;
+
+	while (cache.next_event (time, id, size, buf)) {
+		/* the model copies what it keeps, no need to allocate */
+		Evoral::Event<Temporal::Beats> ev (Evoral::MIDI_EVENT, time, size, const_cast<uint8_t*> (buf), false);
+		_model->append (ev, id < 0 ? Evoral::next_event_id () : id);
+	}
+
+	assert (!_length || (_length.time_domain() == Temporal::BeatTime));
+	_length = max (_length, timepos_t (cache.length ()));
+
+	_model->end_write (Evoral::Sequence<Temporal::Beats>::ResolveStuckNotes, _length.beats());
+	_model->set_edited (false);
+
+	return true;
+}
+
 Evoral::SMF::UsedChannels
 SMFSource::used_midi_channels()
 {
@@ -798,6 +855,7 @@ SMFSource::flush_midi (const WriterLock& lock)
 
 	ensure_disk_file (lock);
 
+	SMFModelCache::remove (_path);
 	Evoral::SMF::end_write (_path);
 	/* data in the file means its no longer removable */
 	mark_nonremovable ();
@@ -808,6 +866,7 @@ SMFSource::flush_midi (const WriterLock& lock)
 void
 SMFSource::set_path (const string& p)
 {
+	SMFModelCache::remove (_path);
 	FileSource::set_path (p);
 }
 
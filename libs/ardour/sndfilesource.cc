@@ -583,16 +583,10 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 
 	/* stride through the interleaved data */
 
+	deinterleave_buffer (dst, ptr, nread, _info.channels);
+
 	if (_gain != 1.f) {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr * _gain;
-			ptr += _info.channels;
-		}
-	} else {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr;
-			ptr += _info.channels;
-		}
+		apply_gain_to_buffer (dst, nread, _gain);
 	}
 
 	return nread;
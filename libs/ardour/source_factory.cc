@@ -56,11 +56,22 @@ PBD::Signal1<void, std::shared_ptr<Source>> SourceFactory::SourceCreated;
 Glib::Threads::Cond                           SourceFactory::PeaksToBuild;
 Glib::Threads::Mutex                          SourceFactory::peak_building_lock;
 std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peaks;
+std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peak_levels;
 std::vector<PBD::Thread*>                     SourceFactory::peak_thread_pool;
 bool                                          SourceFactory::peak_thread_run = false;
 
 static int active_threads = 0;
 
+/* peak_building_lock MUST be held */
+static void
+queue_peak_levels (std::shared_ptr<AudioSource> const& as)
+{
+	if (as->peak_levels_missing ()) {
+		SourceFactory::files_with_peak_levels.push_back (std::weak_ptr<AudioSource> (as));
+		SourceFactory::PeaksToBuild.broadcast ();
+	}
+}
+
 static void
 peak_thread_work ()
 {
@@ -71,7 +82,7 @@ peak_thread_work ()
 		SourceFactory::peak_building_lock.lock ();
 
 	wait:
-		if (SourceFactory::files_with_peaks.empty () && SourceFactory::peak_thread_run) {
+		if (SourceFactory::files_with_peaks.empty () && SourceFactory::files_with_peak_levels.empty () && SourceFactory::peak_thread_run) {
 			SourceFactory::PeaksToBuild.wait (SourceFactory::peak_building_lock);
 			(void) Temporal::TempoMap::fetch();
 		}
@@ -82,7 +93,19 @@ peak_thread_work ()
 		}
 
 		if (SourceFactory::files_with_peaks.empty ()) {
-			goto wait;
+			if (SourceFactory::files_with_peak_levels.empty ()) {
+				goto wait;
+			}
+
+			/* coarser levels of existing peakfiles, once all peakfiles are done */
+			std::shared_ptr<AudioSource> as (SourceFactory::files_with_peak_levels.front ().lock ());
+			SourceFactory::files_with_peak_levels.pop_front ();
+			SourceFactory::peak_building_lock.unlock ();
+
+			if (as) {
+				as->build_peak_levels ();
+			}
+			continue;
 		}
 
 		std::shared_ptr<AudioSource> as (SourceFactory::files_with_peaks.front ().lock ());
@@ -98,6 +121,7 @@ peak_thread_work ()
 
 		as->setup_peakfile ();
 		SourceFactory::peak_building_lock.lock ();
+		queue_peak_levels (as);
 		--active_threads;
 		SourceFactory::peak_building_lock.unlock ();
 	}
@@ -153,6 +177,8 @@ SourceFactory::setup_peakfile (std::shared_ptr<Source> s, bool async)
 				error << string_compose ("SourceFactory: could not set up peakfile for %1", as->name ()) << endmsg;
 				return -1;
 			}
+			Glib::Threads::Mutex::Lock lm (peak_building_lock);
+			queue_peak_levels (as);
 		}
 	}
 
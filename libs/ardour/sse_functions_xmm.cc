@@ -114,5 +114,113 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 	_mm_store_ss(max, work);
 }
 
+/* gain[n] = target + (gain - target) * (1 - coeff)^n
+ * is the closed form of the per-sample recursion
+ * gain += coeff * (target - gain), which allows to compute
+ * four consecutive gain coefficients at once.
+ */
+float
+x86_sse_apply_gain_ramp(ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float gain, float target, float coeff)
+{
+	const float k  = 1.f - coeff;
+	const float k2 = k * k;
+
+	__m128 vkn = _mm_set_ps(k2 * k, k2, k, 1.f);
+	__m128 vk4 = _mm_set1_ps(k2 * k2);
+	__m128 vt  = _mm_set1_ps(target);
+	__m128 vd  = _mm_set1_ps(gain - target);
+
+	while (nframes >= 4) {
+		__m128 g = _mm_add_ps(vt, _mm_mul_ps(vd, vkn));
+		_mm_storeu_ps(buf, _mm_mul_ps(g, _mm_loadu_ps(buf)));
+		vd = _mm_mul_ps(vd, vk4);
+		buf += 4;
+		nframes -= 4;
+	}
+
+	gain = target + _mm_cvtss_f32(vd);
+
+	while (nframes > 0) {
+		*buf++ *= gain;
+		gain += coeff * (target - gain);
+		--nframes;
+	}
+	return gain;
+}
+
+void
+x86_sse_apply_gain_vector_to_buffer(ARDOUR::Sample* buf, const ARDOUR::gain_t* gain, ARDOUR::pframes_t nframes)
+{
+	while (nframes >= 8) {
+		__m128 x0 = _mm_mul_ps(_mm_loadu_ps(buf + 0), _mm_loadu_ps(gain + 0));
+		__m128 x1 = _mm_mul_ps(_mm_loadu_ps(buf + 4), _mm_loadu_ps(gain + 4));
+		_mm_storeu_ps(buf + 0, x0);
+		_mm_storeu_ps(buf + 4, x1);
+		buf += 8;
+		gain += 8;
+		nframes -= 8;
+	}
 
+	if (nframes >= 4) {
+		_mm_storeu_ps(buf, _mm_mul_ps(_mm_loadu_ps(buf), _mm_loadu_ps(gain)));
+		buf += 4;
+		gain += 4;
+		nframes -= 4;
+	}
 
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
+
+void
+x86_sse_interleave_buffer(ARDOUR::Sample* dst, const ARDOUR::Sample* src, ARDOUR::pframes_t nframes, uint32_t stride)
+{
+	if (stride == 2) {
+		/* stereo, keep the samples of the other channel. Each pass
+		 * accesses 8 slots, but the last frame of a group only needs 7:
+		 * the final group is left to the scalar loop, so that a
+		 * channel offset in dst does not write past the end.
+		 */
+		while (nframes > 4) {
+			__m128 s  = _mm_loadu_ps(src);
+			__m128 d0 = _mm_loadu_ps(dst + 0);
+			__m128 d1 = _mm_loadu_ps(dst + 4);
+			__m128 od = _mm_shuffle_ps(d0, d1, _MM_SHUFFLE(3, 1, 3, 1));
+			_mm_storeu_ps(dst + 0, _mm_unpacklo_ps(s, od));
+			_mm_storeu_ps(dst + 4, _mm_unpackhi_ps(s, od));
+			src += 4;
+			dst += 8;
+			nframes -= 4;
+		}
+	}
+
+	while (nframes > 0) {
+		*dst = *src++;
+		dst += stride;
+		--nframes;
+	}
+}
+
+void
+x86_sse_deinterleave_buffer(ARDOUR::Sample* dst, const ARDOUR::Sample* src, ARDOUR::pframes_t nframes, uint32_t stride)
+{
+	if (stride == 2) {
+		/* see x86_sse_interleave_buffer, do not read past the end */
+		while (nframes > 4) {
+			__m128 s0 = _mm_loadu_ps(src + 0);
+			__m128 s1 = _mm_loadu_ps(src + 4);
+			_mm_storeu_ps(dst, _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0)));
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	}
+
+	while (nframes > 0) {
+		*dst++ = *src;
+		src += stride;
+		--nframes;
+	}
+}
@@ -0,0 +1,61 @@
+#include <vector>
+
+#include "ardour/runtime_functions.h"
+#include "ardour/types.h"
+
+#include "interleave_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (InterleaveTest);
+
+using namespace ARDOUR;
+
+static const Sample guard = 12345.f;
+
+/* interleave into the last channel of an exact-size stereo buffer,
+ * checking that the other channel and the slot after the end are untouched
+ */
+void
+InterleaveTest::interleaveTest ()
+{
+	for (pframes_t n = 1; n < 20; ++n) {
+		std::vector<Sample> src (n);
+		std::vector<Sample> buf (2 * n + 1);
+
+		for (pframes_t i = 0; i < n; ++i) {
+			src[i] = i + 1;
+			buf[2 * i] = -1.f - i;
+			buf[2 * i + 1] = 0;
+		}
+		buf[2 * n] = guard;
+
+		interleave_buffer (&buf[1], &src[0], n, 2);
+
+		for (pframes_t i = 0; i < n; ++i) {
+			CPPUNIT_ASSERT_EQUAL (-1.f - i, buf[2 * i]);
+			CPPUNIT_ASSERT_EQUAL (src[i], buf[2 * i + 1]);
+		}
+		CPPUNIT_ASSERT_EQUAL (guard, buf[2 * n]);
+	}
+}
+
+void
+InterleaveTest::deinterleaveTest ()
+{
+	for (pframes_t n = 1; n < 20; ++n) {
+		std::vector<Sample> src (2 * n);
+		std::vector<Sample> dst (n + 1);
+
+		for (pframes_t i = 0; i < n; ++i) {
+			src[2 * i] = -1.f - i;
+			src[2 * i + 1] = i + 1;
+		}
+		dst[n] = guard;
+
+		deinterleave_buffer (&dst[0], &src[1], n, 2);
+
+		for (pframes_t i = 0; i < n; ++i) {
+			CPPUNIT_ASSERT_EQUAL (Sample (i + 1), dst[i]);
+		}
+		CPPUNIT_ASSERT_EQUAL (guard, dst[n]);
+	}
+}
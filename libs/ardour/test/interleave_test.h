@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class InterleaveTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (InterleaveTest);
+	CPPUNIT_TEST (interleaveTest);
+	CPPUNIT_TEST (deinterleaveTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void interleaveTest ();
+	void deinterleaveTest ();
+};
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "pbd/compose.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/port_engine.h"
+
+#include "port_engine_shared_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PortEngineSharedTest);
+
+using namespace ARDOUR;
+
+void
+PortEngineSharedTest::setUp ()
+{
+	create_and_start_dummy_backend ();
+}
+
+void
+PortEngineSharedTest::tearDown ()
+{
+	stop_and_destroy_backend ();
+}
+
+/* Collect the input buffer, as the backend does every cycle,
+ * while connected outputs are unregistered by another thread.
+ */
+static void
+process (PortEngine& pe, PortEngine::PortPtr input, pframes_t n_samples, std::atomic<bool>& run, std::atomic<int>& n_cycles)
+{
+	while (run.load ()) {
+		if (!pe.get_buffer (input, n_samples)) {
+			break;
+		}
+		n_cycles.fetch_add (1);
+	}
+}
+
+void
+PortEngineSharedTest::unregisterWhileProcessingTest ()
+{
+	PortEngine& pe (AudioEngine::instance ()->port_engine ());
+	pframes_t const n_samples = AudioEngine::instance ()->samples_per_cycle ();
+
+	PortEngine::PortPtr input = pe.register_port ("test/in", DataType::AUDIO, IsInput);
+	CPPUNIT_ASSERT (input);
+	std::string const input_name = pe.get_port_name (input);
+
+	std::atomic<bool> run (true);
+	std::atomic<int>  n_cycles (0);
+	std::thread       thread (process, std::ref (pe), input, n_samples, std::ref (run), std::ref (n_cycles));
+
+	for (int i = 0; i < 500; ++i) {
+		std::vector<PortEngine::PortPtr> outputs;
+		for (int c = 0; c < 4; ++c) {
+			outputs.push_back (pe.register_port (string_compose ("test/out %1", c), DataType::AUDIO, IsOutput));
+			CPPUNIT_ASSERT_EQUAL (0, pe.connect (pe.get_port_name (outputs.back ()), input_name));
+		}
+		std::vector<std::string> names;
+		CPPUNIT_ASSERT_EQUAL (4, pe.get_connections (input, names));
+
+		/* unregister the still connected ports, and drop the last reference */
+		for (auto& p : outputs) {
+			pe.unregister_port (p);
+			p.reset ();
+		}
+		CPPUNIT_ASSERT (!pe.connected (input));
+	}
+
+	run.store (false);
+	thread.join ();
+
+	/* the process thread must not have stopped early */
+	CPPUNIT_ASSERT (n_cycles.load () > 0);
+
+	pe.unregister_port (input);
+}
@@ -0,0 +1,15 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class PortEngineSharedTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (PortEngineSharedTest);
+	CPPUNIT_TEST (unregisterWhileProcessingTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void unregisterWhileProcessingTest ();
+};
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <stdlib.h>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+#include "evoral/ControlList.h"
+#include "ardour/ardour.h"
+
+using namespace std;
+using namespace PBD;
+using namespace Temporal;
+
+static const char* localedir = LOCALEDIR;
+
+/* Evaluate a dense automation list at random positions (as the GUI does)
+ * and sequentially (as automation playback does), with and without the
+ * contiguous eval-index.
+ */
+
+static void
+run (Evoral::ControlList& cl, samplepos_t length, int n_evals, bool sequential)
+{
+	double sum = 0;
+	bool   ok;
+	Timing t;
+
+	for (int i = 0; i < n_evals; ++i) {
+		samplepos_t s = sequential ? (i * (int64_t) 64) % length : (rand () % length);
+		sum += cl.rt_safe_eval (timepos_t (s), ok);
+	}
+
+	t.update ();
+	cout << string_compose ("%1 %2 evals (%3): %4 usec (%5 usec/eval) [%6]\n",
+	                        cl.use_eval_index () ? "indexed" : "list   ",
+	                        n_evals, sequential ? "sequential" : "random    ",
+	                        t.elapsed (), t.elapsed () / (double) n_evals, sum);
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_points = argc > 1 ? atoi (argv[1]) : 50000;
+	int n_evals  = argc > 2 ? atoi (argv[2]) : 100000;
+
+	ARDOUR::init (true, localedir);
+
+	{
+		Evoral::Parameter param (0);
+		Evoral::ParameterDescriptor desc;
+
+		Evoral::ControlList cl (param, desc, TimeDomainProvider (AudioTime));
+		cl.set_interpolation (Evoral::ControlList::Linear);
+
+		srand (1);
+		samplepos_t s = 0;
+
+		cl.freeze ();
+		for (int i = 0; i < n_points; ++i) {
+			s += 1 + rand () % 256;
+			cl.fast_simple_add (timepos_t (s), rand () / (double) RAND_MAX);
+		}
+		cl.thaw ();
+
+		cout << string_compose ("INFO: %1 points over %2 samples\n", cl.size (), s);
+
+		for (int pass = 0; pass < 2; ++pass) {
+			cl.set_use_eval_index (pass == 0);
+			run (cl, s, n_evals, false);
+			run (cl, s, n_evals, true);
+		}
+	}
+
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include "pbd/compose.h"
+#include "ardour/ardour.h"
+#include "ardour/convolver.h"
+#include "ardour/readable.h"
+#include "ardour/session.h"
+#include "test_ui.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* Process a long true-stereo impulse response with each of the
+ * Convolution latency modes, and report the latency, the load of
+ * the calling thread and the number of cycles in which background
+ * threads were late.
+ */
+
+class NoiseIR : public AudioReadable
+{
+public:
+	NoiseIR (samplecnt_t len, uint32_t seed) : _len (len), _seed (seed) {}
+
+	samplecnt_t read (Sample* buf, samplepos_t pos, samplecnt_t cnt, int) const {
+		cnt = std::min (cnt, _len - pos);
+		srand (_seed + pos);
+		for (samplecnt_t i = 0; i < cnt; ++i) {
+			/* exponentially decaying noise */
+			buf[i] = (rand () / (float) RAND_MAX - .5f) * expf (-5.f * (pos + i) / _len);
+		}
+		return cnt;
+	}
+
+	samplecnt_t readable_length_samples () const { return _len; }
+	uint32_t    n_channels () const { return 1; }
+
+private:
+	samplecnt_t _len;
+	uint32_t    _seed;
+};
+
+static const char* mode_names[] = { "Unthreaded", "LowLatency", "Balanced  ", "LowCPU    " };
+
+int
+main (int argc, char* argv[])
+{
+	float ir_seconds = argc > 1 ? atof (argv[1]) : 4.f;
+	int   n_seconds  = argc > 2 ? atoi (argv[2]) : 10;
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI();
+	create_and_start_dummy_backend ();
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	{
+
+	samplecnt_t const sr        = session->nominal_sample_rate ();
+	pframes_t const   n_samples = session->get_block_size ();
+	samplecnt_t const ir_len    = ir_seconds * sr;
+
+	cout << string_compose ("INFO: 4 channel IR, %1 samples, block-size %2\n", ir_len, n_samples);
+
+	BufferSet bufs;
+	bufs.ensure_buffers (DataType::AUDIO, 2, n_samples);
+	bufs.set_count (ChanCount (DataType::AUDIO, 2));
+
+	ChanMapping map (ChanCount (DataType::AUDIO, 2));
+
+	for (int m = DSP::Convolution::Unthreaded; m <= DSP::Convolution::LowCPU; ++m) {
+		DSP::Convolution conv (*session, 2, 2);
+		conv.set_latency_mode ((DSP::Convolution::LatencyMode) m);
+		for (uint32_t c = 0; c < 4; ++c) {
+			conv.add_impdata (c / 2, c % 2, std::shared_ptr<AudioReadable> (new NoiseIR (ir_len, c)));
+		}
+		conv.restart ();
+
+		if (!conv.ready ()) {
+			cerr << string_compose ("%1: not ready\n", mode_names[m]);
+			continue;
+		}
+
+		/* run in realtime, background threads process the tail
+		 * partitions concurrently */
+		int64_t const start = g_get_monotonic_time ();
+		for (samplecnt_t done = 0; done < n_seconds * sr; done += n_samples) {
+			int64_t const wait = start + done * 1000000 / sr - g_get_monotonic_time ();
+			if (wait > 0) {
+				g_usleep (wait);
+			}
+			for (uint32_t c = 0; c < 2; ++c) {
+				Sample* d = bufs.get_audio (c).data ();
+				for (pframes_t i = 0; i < n_samples; ++i) {
+					d[i] = rand () / (float) RAND_MAX - .5f;
+				}
+			}
+			conv.run (bufs, map, map, n_samples, 0);
+		}
+
+		cout << string_compose ("%1: latency %2, process thread load %3%%, late cycles %4\n",
+		                        mode_names[m], conv.latency (), 100.f * conv.dsp_load (), conv.late_cycles ());
+	}
+
+	}
+
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <stdlib.h>
+
+#include "pbd/compose.h"
+#include "pbd/malign.h"
+#include "pbd/timing.h"
+#include "ardour/ardour.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare the generic DSP routines with the ones that
+ * setup_hardware_optimization() selected for this CPU.
+ */
+
+static Sample* buf;
+static Sample* src;
+static gain_t* gain;
+static float   sink;
+
+static void gain_generic (pframes_t n) { default_apply_gain_to_buffer (buf, n, .99f); }
+static void gain_rt      (pframes_t n) { apply_gain_to_buffer (buf, n, .99f); }
+static void mix_generic  (pframes_t n) { default_mix_buffers_with_gain (buf, src, n, .5f); }
+static void mix_rt       (pframes_t n) { mix_buffers_with_gain (buf, src, n, .5f); }
+static void ramp_generic (pframes_t n) { sink += default_apply_gain_ramp (buf, n, 0.f, 1.f, 1e-3f); }
+static void ramp_rt      (pframes_t n) { sink += apply_gain_ramp (buf, n, 0.f, 1.f, 1e-3f); }
+static void gvec_generic (pframes_t n) { default_apply_gain_vector_to_buffer (buf, gain, n); }
+static void gvec_rt      (pframes_t n) { apply_gain_vector_to_buffer (buf, gain, n); }
+static void ilv_generic  (pframes_t n) { default_interleave_buffer (src, buf, n / 2, 2); }
+static void ilv_rt       (pframes_t n) { interleave_buffer (src, buf, n / 2, 2); }
+static void dilv_generic (pframes_t n) { default_deinterleave_buffer (buf, src, n / 2, 2); }
+static void dilv_rt      (pframes_t n) { deinterleave_buffer (buf, src, n / 2, 2); }
+
+struct Kernel {
+	const char* name;
+	void (*generic) (pframes_t);
+	void (*rt) (pframes_t);
+};
+
+static double
+run (void (*fn) (pframes_t), pframes_t n_samples, int n_cycles)
+{
+	Timing t;
+	for (int i = 0; i < n_cycles; ++i) {
+		fn (n_samples);
+	}
+	t.update ();
+	return t.elapsed () / (double) n_cycles;
+}
+
+int
+main (int argc, char* argv[])
+{
+	pframes_t n_samples = argc > 1 ? atoi (argv[1]) : 1024;
+	int       n_cycles  = argc > 2 ? atoi (argv[2]) : 100000;
+
+	ARDOUR::init (true, localedir);
+
+	cache_aligned_malloc ((void**) &buf, n_samples * sizeof (Sample));
+	cache_aligned_malloc ((void**) &src, n_samples * sizeof (Sample));
+	cache_aligned_malloc ((void**) &gain, n_samples * sizeof (gain_t));
+
+	srand (1);
+	for (pframes_t i = 0; i < n_samples; ++i) {
+		buf[i]  = rand () / (float) RAND_MAX - .5f;
+		src[i]  = rand () / (float) RAND_MAX - .5f;
+		gain[i] = i / (float) n_samples;
+	}
+
+	const Kernel kernels[] = {
+		{ "apply_gain_to_buffer       ", gain_generic, gain_rt },
+		{ "mix_buffers_with_gain      ", mix_generic,  mix_rt  },
+		{ "apply_gain_ramp            ", ramp_generic, ramp_rt },
+		{ "apply_gain_vector_to_buffer", gvec_generic, gvec_rt },
+		{ "interleave_buffer (2ch)    ", ilv_generic,  ilv_rt  },
+		{ "deinterleave_buffer (2ch)  ", dilv_generic, dilv_rt },
+	};
+
+	cout << string_compose ("INFO: %1 samples, %2 cycles\n", n_samples, n_cycles);
+
+	for (size_t k = 0; k < sizeof (kernels) / sizeof (Kernel); ++k) {
+		/* restore sane levels, repeated gain may decay to denormals */
+		for (pframes_t i = 0; i < n_samples; ++i) {
+			buf[i] = src[i] = rand () / (float) RAND_MAX - .5f;
+		}
+		double g = run (kernels[k].generic, n_samples, n_cycles);
+		double r = run (kernels[k].rt, n_samples, n_cycles);
+		cout << string_compose ("%1: generic %2 usec, runtime %3 usec (x%4)\n",
+		                        kernels[k].name, g, r, r > 0 ? g / r : 0);
+	}
+
+	cache_aligned_free (buf);
+	cache_aligned_free (src);
+	cache_aligned_free (gain);
+
+	ARDOUR::cleanup ();
+	return 0;
+}
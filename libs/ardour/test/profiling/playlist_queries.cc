@@ -0,0 +1,92 @@
+#include "test_ui.h"
+#include "test_util.h"
+#include "ardour/ardour.h"
+#include "ardour/midi_track.h"
+#include "ardour/midi_region.h"
+#include "ardour/session.h"
+#include "ardour/playlist.h"
+#include "pbd/compose.h"
+#include "pbd/stateful_diff_command.h"
+#include "pbd/timing.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* Position queries on a playlist with many regions.
+ *
+ * The playlist is frozen for the second pass, which makes it fall back
+ * to a linear scan of the region-list instead of using the region index.
+ */
+
+static void
+run (std::shared_ptr<Playlist> playlist, samplepos_t length, int n_queries, const char* mode)
+{
+	size_t n = 0;
+	Timing t;
+
+	srand (1);
+	for (int i = 0; i < n_queries; ++i) {
+		timepos_t pos (rand () % length);
+		n += playlist->regions_at (pos)->size ();
+		n += playlist->count_regions_at (pos);
+		n += playlist->top_region_at (pos) ? 1 : 0;
+		n += playlist->regions_touched (pos, pos + timecnt_t (4096))->size ();
+		n += playlist->find_next_region (pos, Start, 1) ? 1 : 0;
+	}
+
+	t.update ();
+	cout << string_compose ("%1: %2 queries: %3 usec (%4 usec/query) [%5]\n",
+	                        mode, n_queries, t.elapsed (), t.elapsed () / (double) n_queries, n);
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_regions = argc > 1 ? atoi (argv[1]) : 20000;
+	int n_queries = argc > 2 ? atoi (argv[2]) : 10000;
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI();
+	create_and_start_dummy_backend ();
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	assert (session->get_routes()->size() == 2);
+
+	{
+
+	/* Find the track */
+	std::shared_ptr<MidiTrack> track = std::dynamic_pointer_cast<MidiTrack> (session->get_routes()->back());
+	assert (track);
+
+	/* And the playlist */
+	std::shared_ptr<Playlist> playlist = track->playlist ();
+	assert (playlist);
+
+	/* And the region */
+	std::shared_ptr<MidiRegion> region = std::dynamic_pointer_cast<MidiRegion> (playlist->region_list_property().rlist().front());
+	assert (region);
+
+	/* Duplicate it a lot */
+	timepos_t pos (region->last_sample() + 1);
+	playlist->duplicate (region, pos, n_regions - 1);
+
+	samplepos_t const length = playlist->get_extent ().second.samples ();
+	cout << string_compose ("INFO: %1 regions over %2 samples\n", playlist->n_regions (), length);
+
+	run (playlist, length, n_queries, "index");
+
+	playlist->freeze ();
+	run (playlist, length, n_queries, "list ");
+	playlist->thaw ();
+
+	}
+
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/port_engine.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* Register many ports with the Dummy backend directly (bypassing the
+ * PortManager), connect each input to several outputs, and measure
+ * the time to connect, to look up ports by pattern, and to collect the
+ * input buffers of all ports once per cycle.
+ */
+
+static void
+report (const char* what, Timing& t, int n)
+{
+	t.update ();
+	cout << string_compose ("%1: %2 usec (%3 usec each)\n", what, t.elapsed (), t.elapsed () / (double) n);
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_ports       = argc > 1 ? atoi (argv[1]) : 2000;
+	int n_connections = argc > 2 ? atoi (argv[2]) : 4;
+	int n_cycles      = argc > 3 ? atoi (argv[3]) : 1000;
+
+	ARDOUR::init (true, localedir);
+	create_and_start_dummy_backend ();
+
+	PortEngine& pe (AudioEngine::instance ()->port_engine ());
+	pframes_t const n_samples = AudioEngine::instance ()->samples_per_cycle ();
+
+	cout << string_compose ("INFO: %1 inputs, %1 outputs, %2 connections/input, %3 cycles of %4 samples\n",
+	                        n_ports, n_connections, n_cycles, n_samples);
+
+	std::vector<PortEngine::PortPtr> inputs;
+	std::vector<PortEngine::PortPtr> outputs;
+	std::vector<std::string>         output_names;
+
+	Timing t;
+	for (int i = 0; i < n_ports; ++i) {
+		outputs.push_back (pe.register_port (string_compose ("bench/out %1", i), DataType::AUDIO, IsOutput));
+		inputs.push_back (pe.register_port (string_compose ("bench/in %1", i), DataType::AUDIO, IsInput));
+		output_names.push_back (pe.get_port_name (outputs.back ()));
+	}
+	report ("register", t, 2 * n_ports);
+
+	t.start ();
+	for (int i = 0; i < n_ports; ++i) {
+		for (int c = 0; c < n_connections; ++c) {
+			pe.connect (inputs[i], output_names[(i + c * 7) % n_ports]);
+		}
+	}
+	report ("connect", t, n_ports * n_connections);
+
+	t.start ();
+	size_t n_found = 0;
+	for (int i = 0; i < 100; ++i) {
+		std::vector<std::string> names;
+		n_found += pe.get_ports (string_compose ("bench/in %1", i), DataType::AUDIO, IsInput, names);
+	}
+	report ("get_ports (regex)", t, 100);
+
+	t.start ();
+	for (int n = 0; n < n_cycles; ++n) {
+		for (int i = 0; i < n_ports; ++i) {
+			pe.get_buffer (outputs[i], n_samples);
+		}
+		for (int i = 0; i < n_ports; ++i) {
+			pe.get_buffer (inputs[i], n_samples);
+		}
+	}
+	report ("cycle (get_buffer, mixdown)", t, n_cycles);
+
+	t.start ();
+	for (int i = 0; i < n_ports; ++i) {
+		pe.disconnect_all (inputs[i]);
+	}
+	report ("disconnect_all", t, n_ports);
+
+	t.start ();
+	for (int i = 0; i < n_ports; ++i) {
+		pe.unregister_port (inputs[i]);
+		pe.unregister_port (outputs[i]);
+	}
+	report ("unregister", t, 2 * n_ports);
+
+	cerr << string_compose ("INFO: matched %1 ports\n", n_found);
+
+	inputs.clear ();
+	outputs.clear ();
+
+	stop_and_destroy_backend ();
+	ARDOUR::cleanup ();
+	return 0;
+}
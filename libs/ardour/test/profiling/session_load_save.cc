@@ -0,0 +1,209 @@
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/signals.h"
+#include "ardour/ardour.h"
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/audiofilesource.h"
+#include "ardour/automation_list.h"
+#include "ardour/gain_control.h"
+#include "ardour/playlist.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/region_factory.h"
+#include "ardour/session.h"
+#include "test_ui.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* Generate a synthetic session, then time loading and saving it.
+ *
+ * Session loading is broken down into phases by the LoadPhase
+ * signal that Session emits while it is constructed: each phase
+ * lasts until the next one starts.
+ *
+ * Results are printed as tab-separated "phase <tab> usec" lines.
+ */
+
+struct Phase {
+	Phase (std::string const& n, int64_t t) : name (n), start (t) {}
+	std::string name;
+	int64_t     start;
+};
+
+static std::vector<Phase> phases;
+
+static void
+load_phase (std::string name)
+{
+	phases.push_back (Phase (name, g_get_monotonic_time ()));
+}
+
+static void
+report (std::string const& name, int64_t usec)
+{
+	cout << name << "\t" << usec << "\n";
+}
+
+static void
+generate (std::string const& dir, std::string const& name, int n_tracks, int n_regions, int n_events, int n_plugins)
+{
+	Session* session = load_session (dir, name);
+
+	std::list<std::shared_ptr<AudioTrack> > tracks = session->new_audio_track (1, 2, 0, n_tracks, "Audio", PresentationInfo::max_order);
+	assert (tracks.size () == (size_t) n_tracks);
+
+	std::shared_ptr<PluginInfo> plugin_info;
+	PluginInfoList const& plugs (PluginManager::instance ().lua_plugin_info ());
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == "ACE High/Low Pass Filter") {
+			plugin_info = *i;
+			break;
+		}
+	}
+	if (n_plugins > 0 && !plugin_info) {
+		cerr << "WARNING: Lua plugin not found, not adding any plugins\n";
+	}
+
+	samplecnt_t const region_length = 4800;
+	Sample* buf = new Sample[region_length];
+	for (samplecnt_t i = 0; i < region_length; ++i) {
+		buf[i] = rand () / (float) RAND_MAX - .5f;
+	}
+
+	time_t now;
+	time (&now);
+	struct tm* xnow = localtime (&now);
+
+	for (std::list<std::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t) {
+		std::shared_ptr<AudioFileSource> src = session->create_audio_source_for_session (1, (*t)->name (), 0);
+		src->write (buf, region_length);
+		src->update_header (0, *xnow, now);
+		src->flush_header ();
+		src->mark_immutable ();
+		src->done_with_peakfile_writes ();
+
+		PropertyList plist;
+		plist.add (Properties::start, timepos_t (0));
+		plist.add (Properties::length, timecnt_t (region_length));
+		plist.add (Properties::name, (*t)->name ());
+		plist.add (Properties::whole_file, true);
+		std::shared_ptr<Region> whole = RegionFactory::create (src, plist);
+
+		std::shared_ptr<Playlist> playlist = (*t)->playlist ();
+		playlist->freeze ();
+		for (int r = 0; r < n_regions; ++r) {
+			std::shared_ptr<Region> region = RegionFactory::create (whole, true, false);
+			playlist->add_region (region, timepos_t (r * 2 * region_length));
+		}
+		playlist->thaw ();
+
+		std::shared_ptr<AutomationList> al = (*t)->gain_control ()->alist ();
+		samplepos_t const extent = std::max<samplepos_t> (1, n_regions) * 2 * region_length;
+		for (int e = 0; e < n_events; ++e) {
+			al->add (timepos_t (e * (extent / std::max (1, n_events))), (e % 2) ? 1.0 : 0.5, false, false);
+		}
+		(*t)->gain_control ()->set_automation_state (Play);
+
+		for (int p = 0; plugin_info && p < n_plugins; ++p) {
+			std::shared_ptr<Processor> proc (new PluginInsert (*session, **t, plugin_info->load (*session)));
+			(*t)->add_processor (proc, PreFader);
+		}
+	}
+
+	delete[] buf;
+
+	session->save_state ("");
+
+	AudioEngine::instance ()->remove_session ();
+	delete session;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_tracks  = argc > 1 ? atoi (argv[1]) : 32;
+	int n_regions = argc > 2 ? atoi (argv[2]) : 100;
+	int n_events  = argc > 3 ? atoi (argv[3]) : 1000;
+	int n_plugins = argc > 4 ? atoi (argv[4]) : 2;
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI();
+	create_and_start_dummy_backend ();
+
+	std::string const name ("bench");
+	std::string const dir = Glib::build_filename (new_test_output_dir ("session_load_save"), name);
+
+	cerr << string_compose ("INFO: %1 tracks, %2 regions/track, %3 automation events/track, %4 plugins/track in %5\n",
+	                        n_tracks, n_regions, n_events, n_plugins, dir);
+
+	int64_t t0 = g_get_monotonic_time ();
+	generate (dir, name, n_tracks, n_regions, n_events, n_plugins);
+	int64_t t1 = g_get_monotonic_time ();
+
+	cout << "phase\tusec\n";
+	report ("generate", t1 - t0);
+
+	/* load */
+
+	ScopedConnection c;
+	Session::LoadPhase.connect_same_thread (c, boost::bind (&load_phase, _1));
+
+	phases.push_back (Phase ("construct", g_get_monotonic_time ()));
+	Session* session = load_session (dir, name);
+	int64_t const loaded = g_get_monotonic_time ();
+
+	c.disconnect ();
+
+	for (size_t i = 0; i < phases.size (); ++i) {
+		int64_t const end = i + 1 < phases.size () ? phases[i + 1].start : loaded;
+		report ("load: " + phases[i].name, end - phases[i].start);
+	}
+	report ("load", loaded - phases.front ().start);
+
+	/* save */
+
+	t0 = g_get_monotonic_time ();
+	session->save_state ("");
+	t1 = g_get_monotonic_time ();
+	report ("save", t1 - t0);
+
+	/* autosave: the first one fills the playlist state cache, the
+	 * second one is unchanged. The state is collected in the calling
+	 * thread, and the file is written in the background.
+	 * remove_pending_capture_state() waits for the write to complete.
+	 */
+	for (int i = 0; i < 2; ++i) {
+		std::string const what (i == 0 ? "autosave" : "autosave (unchanged)");
+
+		t0 = g_get_monotonic_time ();
+		session->save_state_async ();
+		t1 = g_get_monotonic_time ();
+		session->remove_pending_capture_state ();
+		int64_t const t2 = g_get_monotonic_time ();
+
+		report (what + ": collect", t1 - t0);
+		report (what + ": write", t2 - t1);
+	}
+
+	t0 = g_get_monotonic_time ();
+	AudioEngine::instance ()->remove_session ();
+	delete session;
+	t1 = g_get_monotonic_time ();
+	report ("close", t1 - t0);
+
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <string.h>
+
+#ifdef COMPILER_MSVC
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include <glib.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/gstdio_compat.h"
+
+#include "ardour/smf_model_cache.h"
+
+#include "smf_model_cache_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SMFModelCacheTest);
+
+using namespace ARDOUR;
+using namespace Temporal;
+
+static uint8_t const note_on[3]  = { 0x90, 60, 100 };
+static uint8_t const note_off[3] = { 0x80, 60, 0 };
+static uint8_t const pgm[2]      = { 0xc1, 7 };
+
+void
+SMFModelCacheTest::setUp ()
+{
+	/* the cache only looks at the file's size and mtime, the content need not be a valid SMF */
+	_smf_path = Glib::build_filename (new_test_output_dir ("smf_model_cache"), "test.mid");
+	write_smf ("MThd");
+}
+
+void
+SMFModelCacheTest::tearDown ()
+{
+	SMFModelCache::remove (_smf_path);
+	::g_unlink (_smf_path.c_str ());
+}
+
+void
+SMFModelCacheTest::write_smf (char const* data)
+{
+	FILE* f = g_fopen (_smf_path.c_str (), "wb");
+	CPPUNIT_ASSERT (f);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, fwrite (data, strlen (data), 1, f));
+	fclose (f);
+}
+
+void
+SMFModelCacheTest::write_cache ()
+{
+	Evoral::SMF::UsedChannels used;
+	used.set (0);
+	used.set (1);
+
+	SMFModelCache cache (_smf_path);
+	cache.add_event (Beats (0, 0), 1, sizeof (note_on), note_on);
+	cache.add_event (Beats (0, 960), -1, sizeof (pgm), pgm);
+	cache.add_event (Beats (1, 0), 2, sizeof (note_off), note_off);
+	CPPUNIT_ASSERT_EQUAL (0, cache.write (1, true, used, Beats (4, 0)));
+}
+
+void
+SMFModelCacheTest::roundTripTest ()
+{
+	write_cache ();
+
+	SMFModelCache cache (_smf_path);
+	CPPUNIT_ASSERT (cache.open ());
+
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, cache.n_note_on_events ());
+	CPPUNIT_ASSERT (cache.has_pgm_change ());
+	CPPUNIT_ASSERT (cache.used_channels ().test (0));
+	CPPUNIT_ASSERT (cache.used_channels ().test (1));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, cache.used_channels ().count ());
+	CPPUNIT_ASSERT (cache.length () == Beats (4, 0));
+
+	Beats              time;
+	Evoral::event_id_t id;
+	uint32_t           size;
+	uint8_t const*     buf;
+
+	CPPUNIT_ASSERT (cache.next_event (time, id, size, buf));
+	CPPUNIT_ASSERT (time == Beats (0, 0));
+	CPPUNIT_ASSERT_EQUAL ((Evoral::event_id_t) 1, id);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) sizeof (note_on), size);
+	CPPUNIT_ASSERT (memcmp (buf, note_on, size) == 0);
+
+	CPPUNIT_ASSERT (cache.next_event (time, id, size, buf));
+	CPPUNIT_ASSERT (time == Beats (0, 960));
+	CPPUNIT_ASSERT_EQUAL ((Evoral::event_id_t) -1, id);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) sizeof (pgm), size);
+	CPPUNIT_ASSERT (memcmp (buf, pgm, size) == 0);
+
+	CPPUNIT_ASSERT (cache.next_event (time, id, size, buf));
+	CPPUNIT_ASSERT (time == Beats (1, 0));
+	CPPUNIT_ASSERT_EQUAL ((Evoral::event_id_t) 2, id);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) sizeof (note_off), size);
+	CPPUNIT_ASSERT (memcmp (buf, note_off, size) == 0);
+
+	CPPUNIT_ASSERT (!cache.next_event (time, id, size, buf));
+	cache.close ();
+
+	/* writing again replaces the existing cache */
+	write_cache ();
+	CPPUNIT_ASSERT (cache.open ());
+}
+
+void
+SMFModelCacheTest::staleSizeTest ()
+{
+	write_cache ();
+	write_smf ("MThdMTrk");
+
+	SMFModelCache cache (_smf_path);
+	CPPUNIT_ASSERT (!cache.open ());
+}
+
+void
+SMFModelCacheTest::staleMtimeTest ()
+{
+	write_cache ();
+
+	GStatBuf statbuf;
+	CPPUNIT_ASSERT (g_stat (_smf_path.c_str (), &statbuf) == 0);
+
+	/* same size, different modification time */
+	struct utimbuf times;
+	times.actime  = statbuf.st_atime;
+	times.modtime = statbuf.st_mtime - 10;
+	CPPUNIT_ASSERT (g_utime (_smf_path.c_str (), &times) == 0);
+
+	SMFModelCache cache (_smf_path);
+	CPPUNIT_ASSERT (!cache.open ());
+}
@@ -0,0 +1,27 @@
+#include <string>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SMFModelCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (SMFModelCacheTest);
+	CPPUNIT_TEST (roundTripTest);
+	CPPUNIT_TEST (staleSizeTest);
+	CPPUNIT_TEST (staleMtimeTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void roundTripTest ();
+	void staleSizeTest ();
+	void staleMtimeTest ();
+
+private:
+	void write_smf (char const* data);
+	void write_cache ();
+
+	std::string _smf_path;
+};
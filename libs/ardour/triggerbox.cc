@@ -1248,12 +1248,503 @@ Trigger::start_and_roll_to (samplepos_t start_pos, samplepos_t end_position, Tri
 
 
 
+/*--------------------*/
+
+AudioClipData::Cache AudioClipData::_cache;
+Glib::Threads::Mutex AudioClipData::_cache_lock;
+
+/* samples per channel read by each call to AudioClipData::stream () */
+static const samplecnt_t clip_stream_chunk = 262144;
+
+/* This exists so that we can play with the value easily. Currently, 1024 seems as good as any */
+static const samplecnt_t rb_blocksize = 1024;
+
+/* stretch requests store the ratio as an integer */
+static const double stretch_ratio_scale = 1e8;
+
+/* input samples per channel studied or processed by each call to AudioClipData::render_stretch () */
+static const samplecnt_t stretch_render_chunk = 65536;
+
+/* number of stretched copies that are kept per clip */
+static const size_t max_stretched_per_clip = 4;
+
+static RubberBand::RubberBandStretcher::Option
+stretch_mode_option (Trigger::StretchMode sm)
+{
+	using namespace RubberBand;
+
+	//map our internal enum to a rubberband option
+	switch (sm) {
+		case Trigger::Crisp  : return RubberBandStretcher::OptionTransientsCrisp;
+		case Trigger::Mixed  : return RubberBandStretcher::OptionTransientsMixed;
+		case Trigger::Smooth : return RubberBandStretcher::OptionTransientsSmooth;
+	}
+	return RubberBandStretcher::Option (0);
+}
+
+AudioClipData::Key::Key (AudioRegion const& r)
+	: start (r.start_sample ())
+	, length (r.length_samples ())
+{
+	for (uint32_t n = 0; n < r.n_channels (); ++n) {
+		sources.push_back (r.source (n)->id ());
+	}
+}
+
+bool
+AudioClipData::Key::operator< (Key const& other) const
+{
+	if (start != other.start) {
+		return start < other.start;
+	}
+	if (length != other.length) {
+		return length < other.length;
+	}
+	return sources < other.sources;
+}
+
+AudioClipData::AudioClipData (std::shared_ptr<AudioRegion> r)
+	: _length (r->length_samples ())
+	, _head (0)
+	, _loaded (0)
+	, _wanted (-1)
+	, _region (r)
+	, _read_failed (false)
+	, _tempo (-1)
+	, _stretched (new StretchedList)
+	, _stretch_request (0)
+	, _stretch_rate (0)
+	, _stretchable (true)
+{
+	for (uint32_t n = 0; n < r->n_channels (); ++n) {
+		_channels.push_back (new Sample[_length]);
+	}
+}
+
+AudioClipData::~AudioClipData ()
+{
+	for (auto& c : _channels) {
+		delete [] c;
+	}
+}
+
+std::shared_ptr<AudioClipData>
+AudioClipData::get (std::shared_ptr<AudioRegion> region, samplecnt_t head_samples)
+{
+	Key const key (*region);
+
+	std::shared_ptr<AudioClipData> clip;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_cache_lock);
+
+		for (Cache::iterator i = _cache.begin (); i != _cache.end ();) {
+			if (i->second.expired ()) {
+				_cache.erase (i++);
+			} else {
+				++i;
+			}
+		}
+
+		Cache::iterator i = _cache.find (key);
+		if (i != _cache.end ()) {
+			clip = i->second.lock ();
+		}
+
+		if (!clip) {
+			try {
+				clip.reset (new AudioClipData (region));
+			} catch (...) {
+				return std::shared_ptr<AudioClipData> ();
+			}
+
+			/* other threads asking for this clip wait for the read lock,
+			 * but not for the cache lock while the data is read.
+			 */
+			clip->_read_lock.lock ();
+			_cache[key] = clip;
+			lm.release ();
+
+			clip->read_head (head_samples);
+			clip->_read_lock.unlock ();
+
+			if (clip->_read_failed) {
+				Glib::Threads::Mutex::Lock cl (_cache_lock);
+				Cache::iterator c = _cache.find (key);
+				if (c != _cache.end () && c->second.lock () == clip) {
+					_cache.erase (c);
+				}
+				return std::shared_ptr<AudioClipData> ();
+			}
+
+			if (clip->_region) {
+				/* read the rest in the background */
+				TriggerBox::worker->stream_clip (clip);
+			}
+
+			return clip;
+		}
+	}
+
+	/* wait until the data is read by the thread that added it */
+	Glib::Threads::Mutex::Lock lm (clip->_read_lock);
+
+	if (clip->_read_failed) {
+		return std::shared_ptr<AudioClipData> ();
+	}
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("re-use clip data for %1\n", region->name ()));
+	return clip;
+}
+
+void
+AudioClipData::read_head (samplecnt_t head_samples)
+{
+	bool const streaming = head_samples > 0 && head_samples < _length && TriggerBox::worker;
+
+	try {
+		read (streaming ? head_samples : _length);
+	} catch (...) {
+		_read_failed = true;
+		return;
+	}
+
+	_head = loaded ();
+
+	if (streaming) {
+		/* the rest is silent until the TriggerBoxThread read it */
+		for (auto& c : _channels) {
+			memset (c + _head, 0, sizeof (Sample) * (_length - _head));
+		}
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("stream clip data for %1, read %2 of %3\n", _region->name (), _head, _length));
+	} else {
+		_region.reset ();
+	}
+}
+
+size_t
+AudioClipData::cache_size (size_t& bytes)
+{
+	Glib::Threads::Mutex::Lock lm (_cache_lock);
+
+	size_t n = 0;
+	bytes = 0;
+
+	for (Cache::const_iterator i = _cache.begin (); i != _cache.end (); ++i) {
+		std::shared_ptr<AudioClipData> clip (i->second.lock ());
+		if (clip) {
+			++n;
+			bytes += clip->n_channels () * clip->length () * sizeof (Sample);
+		}
+	}
+	return n;
+}
+
+void
+AudioClipData::read (samplecnt_t cnt)
+{
+	samplepos_t const pos = _loaded.load ();
+
+	cnt = std::min (cnt, _length - pos);
+
+	for (uint32_t n = 0; n < _channels.size (); ++n) {
+		_region->read (_channels[n] + pos, pos, cnt, n);
+	}
+
+	_loaded.store (pos + cnt);
+}
+
+bool
+AudioClipData::stream ()
+{
+	if (!_region) {
+		return false;
+	}
+
+	try {
+		read (clip_stream_chunk);
+	} catch (...) {
+		error << string_compose (_("Could not read clip data for %1"), _region->name ()) << endmsg;
+		_region.reset ();
+		_stretchable.store (false);
+		return false;
+	}
+
+	if (loaded () < _length) {
+		return true;
+	}
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("done streaming clip data for %1\n", _region->name ()));
+	_region.reset ();
+	return false;
+}
+
+bool
+AudioClipData::wanted () const
+{
+	samplepos_t const w = _wanted.load ();
+	return w >= 0 && w + clip_stream_chunk > loaded () && loaded () < _length;
+}
+
+AudioClipData::Stretched::Stretched (uint32_t n_channels, samplecnt_t len, double r, Trigger::StretchMode sm)
+	: length (len)
+	, ratio (r)
+	, mode (sm)
+{
+	for (uint32_t n = 0; n < n_channels; ++n) {
+		channels.push_back (new Sample[length]);
+	}
+}
+
+AudioClipData::Stretched::~Stretched ()
+{
+	for (auto& c : channels) {
+		delete [] c;
+	}
+}
+
+AudioClipData::Stretched const*
+AudioClipData::find_stretched (StretchedList const& sl, double ratio, Trigger::StretchMode sm)
+{
+	for (auto const& s : sl) {
+		if (s->mode == sm && fabs (s->ratio - ratio) < 1e-6 * ratio) {
+			return s.get ();
+		}
+	}
+	return 0;
+}
+
+void
+AudioClipData::request_stretch (double ratio, Trigger::StretchMode sm, samplecnt_t sample_rate)
+{
+	_stretch_rate.store (sample_rate);
+	_stretch_request.store ((llrint (ratio * stretch_ratio_scale) << 2) | sm);
+}
+
+std::vector<std::shared_ptr<AudioClipData> >
+AudioClipData::stretch_requests ()
+{
+	std::vector<std::shared_ptr<AudioClipData> > rv;
+
+	Glib::Threads::Mutex::Lock lm (_cache_lock);
+
+	for (Cache::const_iterator i = _cache.begin (); i != _cache.end (); ++i) {
+		std::shared_ptr<AudioClipData> clip (i->second.lock ());
+		if (clip && (clip->_stretch_request.load () != 0 || clip->_render)) {
+			rv.push_back (clip);
+		}
+	}
+	return rv;
+}
+
+void
+AudioClipData::drop_unused_stretches ()
+{
+	Glib::Threads::Mutex::Lock lm (_cache_lock);
+
+	for (Cache::const_iterator i = _cache.begin (); i != _cache.end (); ++i) {
+		std::shared_ptr<AudioClipData> clip (i->second.lock ());
+		if (clip) {
+			clip->_stretched.cleanup ();
+		}
+	}
+}
+
+struct AudioClipData::StretchRender {
+	StretchRender (int64_t rq, samplecnt_t sample_rate, uint32_t n_channels, std::shared_ptr<Stretched> const& st)
+		: req (rq)
+		, rb (sample_rate, n_channels, RubberBand::RubberBandStretcher::OptionProcessOffline | RubberBand::RubberBandStretcher::OptionThreadingNever | stretch_mode_option (st->mode), st->ratio, 1.0)
+		, s (st)
+		, studied (0)
+		, processed (0)
+		, written (0)
+		, t0 (g_get_monotonic_time ())
+	{
+		rb.setMaxProcessSize (rb_blocksize);
+	}
+
+	int64_t                          req;
+	RubberBand::RubberBandStretcher  rb;
+	std::shared_ptr<Stretched>       s;
+	samplecnt_t                      studied;
+	samplecnt_t                      processed;
+	samplecnt_t                      written;
+	int64_t                          t0;
+};
+
+bool
+AudioClipData::start_stretch ()
+{
+	int64_t req = _stretch_request.load ();
+
+	if (req == 0) {
+		return false;
+	}
+
+	if (loaded () < _length && _region) {
+		/* still streaming, try again later */
+		return false;
+	}
+
+	if (!_stretch_request.compare_exchange_strong (req, 0) || !stretchable ()) {
+		/* replaced by a newer request, or the clip could not be read */
+		return false;
+	}
+
+	double const               ratio = (req >> 2) / stretch_ratio_scale;
+	Trigger::StretchMode const sm    = Trigger::StretchMode (req & 3);
+	uint32_t const             nchans = n_channels ();
+
+	if (nchans == 0 || find_stretched (*stretched (), ratio, sm)) {
+		return false;
+	}
+
+	try {
+		std::shared_ptr<Stretched> s (new Stretched (nchans, ceil (_length * ratio), ratio, sm));
+		_render.reset (new StretchRender (req, _stretch_rate.load (), nchans, s));
+	} catch (...) {
+		error << _("Could not allocate memory for a stretched clip") << endmsg;
+		_stretchable.store (false);
+		return false;
+	}
+
+	_render->rb.setExpectedInputDuration (_length);
+	return true;
+}
+
+bool
+AudioClipData::render_stretch ()
+{
+	int64_t req = _stretch_request.load ();
+
+	if (_render && req == _render->req) {
+		/* requested again while rendering */
+		_stretch_request.compare_exchange_strong (req, 0);
+	}
+
+	/* A different request (another trigger, or a tempo change) stays
+	 * pending until the running render is finished. Abandoning it would
+	 * let triggers with different ratios cancel each other's renders.
+	 */
+
+	if (!_render && !start_stretch ()) {
+		return false;
+	}
+
+	StretchRender& r (*_render);
+	Stretched&     s (*r.s);
+
+	uint32_t const nchans = n_channels ();
+
+	std::vector<Sample const*> in (nchans);
+	std::vector<Sample*>       out (nchans);
+
+	/* study, then process at most stretch_render_chunk samples per call,
+	 * so that other requests are handled in between.
+	 */
+
+	if (r.studied < _length) {
+		samplecnt_t const end = std::min (_length, r.studied + stretch_render_chunk);
+		while (r.studied < end) {
+			samplecnt_t const n = std::min<samplecnt_t> (rb_blocksize, _length - r.studied);
+			for (uint32_t c = 0; c < nchans; ++c) {
+				in[c] = _channels[c] + r.studied;
+			}
+			r.rb.study (&in[0], n, r.studied + n == _length);
+			r.studied += n;
+		}
+		return true;
+	}
+
+	samplecnt_t const end = std::min (_length, r.processed + stretch_render_chunk);
+
+	/* feed the input, and retrieve the output until the stretcher is done */
+	while (true) {
+		if (r.processed < end) {
+			samplecnt_t const n = std::min<samplecnt_t> (rb_blocksize, _length - r.processed);
+			for (uint32_t c = 0; c < nchans; ++c) {
+				in[c] = _channels[c] + r.processed;
+			}
+			r.rb.process (&in[0], n, r.processed + n == _length);
+			r.processed += n;
+		}
+
+		int const avail = r.rb.available ();
+
+		if (avail < 0 || r.written == s.length) {
+			/* done, or more output than expected: drop it */
+			break;
+		}
+
+		if (avail == 0) {
+			if (r.processed == _length) {
+				/* the stretcher does not use threads, all output
+				 * is available once the final block was processed.
+				 */
+				break;
+			}
+			if (r.processed == end) {
+				/* all input of this chunk was fed, come back later */
+				return true;
+			}
+			continue;
+		}
+
+		for (uint32_t c = 0; c < nchans; ++c) {
+			out[c] = s.channels[c] + r.written;
+		}
+		r.written += r.rb.retrieve (&out[0], std::min<samplecnt_t> (avail, s.length - r.written));
+	}
+
+	finish_stretch ();
+	return false;
+}
+
+void
+AudioClipData::finish_stretch ()
+{
+	StretchRender& r (*_render);
+	Stretched&     s (*r.s);
+
+	for (auto& c : s.channels) {
+		memset (c + r.written, 0, sizeof (Sample) * (s.length - r.written));
+	}
+
+	{
+		RCUWriter<StretchedList> writer (_stretched);
+		std::shared_ptr<StretchedList> sl = writer.get_copy ();
+		if (sl->size () >= max_stretched_per_clip) {
+			sl->erase (sl->begin ());
+		}
+		sl->push_back (r.s);
+	}
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("rendered stretch ratio %1 (%2 -> %3 samples) in %4 ms\n", s.ratio, _length, r.written, (g_get_monotonic_time () - r.t0) / 1000));
+
+	_render.reset ();
+}
+
+double
+AudioClipData::estimated_tempo (samplecnt_t sample_rate)
+{
+	Glib::Threads::Mutex::Lock lm (_tempo_lock);
+
+	if (_tempo < 0) {
+		breakfastquay::MiniBPM mbpm (sample_rate);
+		_tempo = _channels.empty () ? 0 : mbpm.estimateTempoOfSamples (_channels[0], _head);
+	}
+	return _tempo;
+}
+
 /*--------------------*/
 
 AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	: Trigger (n, b)
 	, _stretcher (0)
 	, _start_offset (0)
+	, _stretched (0)
+	, _stretched_index (0)
+	, _select_stretched (false)
 	, read_index (0)
 	, last_readable_sample (0)
 	, _legato_offset (0)
@@ -1261,6 +1752,7 @@ AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	, got_stretcher_padding (false)
 	, to_pad (0)
 	, to_drop (0)
+	, stretcher_preroll (false)
 {
 }
 
@@ -1678,9 +2170,8 @@ AudioTrigger::estimate_tempo ()
 
 		if (text_tempo < 0) {
 
-			breakfastquay::MiniBPM mbpm (_box.session().sample_rate());
-
-			_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], data.length);
+			/* computed once for all triggers sharing the data */
+			_estimated_tempo = data.clip ? data.clip->estimated_tempo (_box.session().sample_rate()) : 0;
 
 			//cerr << name() << "MiniBPM Estimated: " << _estimated_tempo << " bpm from " << (double) data.length / _box.session().sample_rate() << " seconds\n";
 		}
@@ -1754,9 +2245,6 @@ AudioTrigger::io_change ()
 	}
 }
 
-/* This exists so that we can play with the value easily. Currently, 1024 seems as good as any */
-static const samplecnt_t rb_blocksize = 1024;
-
 void
 AudioTrigger::reset_stretcher ()
 {
@@ -1764,6 +2252,7 @@ AudioTrigger::reset_stretcher ()
 	got_stretcher_padding = false;
 	to_pad = 0;
 	to_drop = 0;
+	stretcher_preroll = false;
 }
 
 void
@@ -1779,16 +2268,8 @@ AudioTrigger::setup_stretcher ()
 	std::shared_ptr<AudioRegion> ar (std::dynamic_pointer_cast<AudioRegion> (_region));
 	const uint32_t nchans = std::min (_box.input_streams().n_audio(), ar->n_channels());
 
-	//map our internal enum to a rubberband option
-	RubberBandStretcher::Option ro = RubberBandStretcher::Option (0);
-	switch (_stretch_mode) {
-		case Trigger::Crisp  : ro = RubberBandStretcher::OptionTransientsCrisp; break;
-		case Trigger::Mixed  : ro = RubberBandStretcher::OptionTransientsMixed; break;
-		case Trigger::Smooth : ro = RubberBandStretcher::OptionTransientsSmooth; break;
-	}
-
 	RubberBandStretcher::Options options = RubberBandStretcher::Option (RubberBandStretcher::OptionProcessRealTime |
-	                                                                    ro);
+	                                                                    stretch_mode_option (_stretch_mode));
 
 	delete _stretcher;
 	_stretcher = new RubberBandStretcher (_box.session().sample_rate(), nchans, options, 1.0, 1.0);
@@ -1798,33 +2279,34 @@ AudioTrigger::setup_stretcher ()
 void
 AudioTrigger::drop_data ()
 {
-	for (auto& d : data) {
-		delete [] d;
-	}
+	release_stretched ();
 	data.clear ();
+	data.clip.reset ();
 }
 
 int
 AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
 {
-	const uint32_t nchans = ar->n_channels();
-
 	data.length = ar->length_samples();
 	drop_data ();
 
-	try {
-		for (uint32_t n = 0; n < nchans; ++n) {
-			data.push_back (new Sample[data.length]);
-			ar->read (data[n], 0, data.length, n);
-		}
+	/* the data is shared with other triggers using the same sources and range */
+	samplecnt_t const head = Config->get_clip_stream_seconds () * _box.session().sample_rate();
 
-		set_name (ar->name());
+	std::shared_ptr<AudioClipData> clip = AudioClipData::get (ar, head);
 
-	} catch (...) {
-		drop_data ();
+	if (!clip) {
 		return -1;
 	}
 
+	data.clip = clip;
+
+	for (uint32_t n = 0; n < clip->n_channels (); ++n) {
+		data.push_back (clip->channel (n));
+	}
+
+	set_name (ar->name());
+
 	return 0;
 }
 
@@ -1840,9 +2322,75 @@ AudioTrigger::retrigger ()
 	retrieved = 0;
 	_legato_offset = 0; /* used one time only */
 
+	/* a pre-rendered stretch is selected at the start of each pass */
+	release_stretched ();
+	_select_stretched = true;
+
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 retriggered to %2\n", _index, read_index));
 }
 
+void
+AudioTrigger::release_stretched ()
+{
+	/* Releasing _stretched_list never deletes it here, the RCU manager
+	 * keeps old lists until the TriggerBoxThread drops them. Wake it
+	 * up, in case this was the last user of an old list.
+	 */
+	const bool old = _stretched_list && data.clip && _stretched_list != data.clip->stretched ();
+
+	_stretched = 0;
+	_stretched_list.reset ();
+
+	if (old && TriggerBox::worker) {
+		TriggerBox::worker->release_stretch ();
+	}
+}
+
+void
+AudioTrigger::use_stretched (double bpm)
+{
+	/* called from process context */
+
+	const bool   stretch = stretching() && _segment_tempo > 1 && data.clip;
+	const double ratio   = stretch ? _segment_tempo / bpm : 0;
+
+	if (_stretched) {
+		if (!stretch || _stretched->mode != _stretch_mode || fabs (_stretched->ratio - ratio) >= 1e-6 * ratio) {
+			/* the tempo changed during this pass, continue with the realtime
+			 * stretcher, primed with the data before the current position.
+			 */
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 tempo changed, stop using pre-rendered stretch\n", index()));
+			release_stretched ();
+			reset_stretcher ();
+			stretcher_preroll = true;
+		}
+		return;
+	}
+
+	if (!stretch || !_select_stretched) {
+		return;
+	}
+
+	_select_stretched = false;
+
+	_stretched_list = data.clip->stretched ();
+	_stretched = AudioClipData::find_stretched (*_stretched_list, ratio, _stretch_mode);
+
+	if (_stretched) {
+		_stretched_index = llrint (read_index * _stretched->ratio);
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 using pre-rendered stretch, ratio %2\n", index(), ratio));
+		return;
+	}
+
+	release_stretched ();
+
+	if (!data.clip->stretch_requested () && data.clip->stretchable () && TriggerBox::worker) {
+		/* stretch in realtime until the render is ready */
+		data.clip->request_stretch (ratio, _stretch_mode, _box.session().sample_rate());
+		TriggerBox::worker->request_stretch ();
+	}
+}
+
 template<bool in_process_context>
 pframes_t
 AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample,
@@ -1856,7 +2404,6 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 	BufferSet* scratch;
 	std::unique_ptr<BufferSet> scratchp;
 	std::vector<Sample*> bufp(nchans);
-	const bool do_stretch = stretching() && _segment_tempo > 1;
 
 	quantize_offset = 0;
 
@@ -1864,6 +2411,9 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 	maybe_compute_next_transition (start_sample, start, end, nframes, quantize_offset);
 	const pframes_t orig_nframes = nframes;
 
+	use_stretched (bpm);
+	const bool do_stretch = stretching() && _segment_tempo > 1 && !_stretched;
+
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1/%2 after checking for transition, state = %3, start = %9 will stretch %4, nf will be %5 of %6, dest_offset %7 q-offset %8\n",
 	                                              index(), name(), enum_2_string (_state), do_stretch, nframes,  orig_nframes, dest_offset, quantize_offset, start_sample));
 
@@ -1883,6 +2433,23 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		break;
 	}
 
+	if (in_process_context && data.clip && !_stretched && data.clip->loaded () < data.length) {
+		/* The clip is still being streamed. Ask the TriggerBoxThread to
+		 * read ahead of this trigger first, and hold playback until the
+		 * data for this cycle was read, rather than playing silence.
+		 */
+		data.clip->want (read_index);
+
+		samplecnt_t need = 2 * std::max<samplecnt_t> (nframes, rb_blocksize);
+		if (do_stretch) {
+			need = ceil (need * std::max (1.0, bpm / _segment_tempo));
+		}
+		if (data.clip->loaded () < std::min<samplecnt_t> (data.length, read_index + need)) {
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 waits for clip data at %2, read %3\n", index(), read_index, data.clip->loaded ()));
+			return nframes;
+		}
+	}
+
 	/* We use session scratch buffers for both padding the start of the
 	 * input to RubberBand, and to hold the output. Because of this dual
 	 * purpose, we use a generic variable name ('bufp') to refer to them.
@@ -1945,8 +2512,15 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 requires %2 padding %3\n", name(), to_pad));
 		}
 
-		while (to_pad > 0) {
-			const samplecnt_t limit = std::min ((samplecnt_t) scratch->get_audio (0).capacity(), to_pad);
+		/* When taking over from a pre-rendered stretch in the middle of
+		 * a pass, pad with the data before read_index rather than
+		 * silence, so that the output continues without a gap.
+		 */
+		const samplecnt_t preroll = stretcher_preroll ? std::min<samplecnt_t> (to_pad, read_index) : 0;
+		stretcher_preroll = false;
+
+		while (to_pad > preroll) {
+			const samplecnt_t limit = std::min ((samplecnt_t) scratch->get_audio (0).capacity(), to_pad - preroll);
 			for (uint32_t chn = 0; chn < nchans; ++chn) {
 				memset (bufp[chn], 0, sizeof (Sample) * limit);
 			}
@@ -1955,12 +2529,28 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 			to_pad -= limit;
 			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 padded %2 left %3\n", name(), limit, to_pad));
 		}
+
+		/* copy the data into the scratch buffers, so that no pointer
+		 * array has to be allocated here.
+		 */
+		while (to_pad > 0) {
+			const samplecnt_t limit = std::min ((samplecnt_t) scratch->get_audio (0).capacity(), to_pad);
+
+			for (uint32_t chn = 0; chn < nchans; ++chn) {
+				memcpy (bufp[chn], data[chn] + read_index - to_pad, sizeof (Sample) * limit);
+			}
+
+			_stretcher->process (&bufp[0], limit, false);
+			to_pad -= limit;
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 padded %2 from data, left %3\n", name(), limit, to_pad));
+		}
 	}
 
 	while (nframes && !_playout) {
 
 		pframes_t to_stretcher;
 		pframes_t from_stretcher;
+		samplecnt_t stretched_end = 0;
 
 		if (do_stretch) {
 
@@ -2053,6 +2643,11 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 				}
 			}
 
+		} else if (_stretched) {
+			/* pre-rendered stretch, do not run past the end of the stretched data or the trigger */
+			stretched_end = std::min<samplecnt_t> (_stretched->length, llrint (last_readable_sample * _stretched->ratio));
+			from_stretcher = std::min<samplecnt_t> (nframes, std::max<samplecnt_t> (0, stretched_end - _stretched_index));
+			from_stretcher = std::min<samplecnt_t> (from_stretcher, std::max<samplecnt_t> (0, final_processed_sample - process_index));
 		} else {
 			/* no stretch */
 			assert (last_readable_sample >= read_index);
@@ -2071,7 +2666,15 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample* src;
+
+				if (do_stretch) {
+					src = bufp[channel];
+				} else if (_stretched) {
+					src = _stretched->channels[channel] + _stretched_index;
+				} else {
+					src = data[channel] + read_index;
+				}
 
 				gain_t gain;
 
@@ -2096,7 +2699,15 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		 * stretcher
 		 */
 
-		if (!do_stretch) {
+		if (_stretched) {
+			/* keep read_index in sync, in case we need to continue with the realtime stretcher */
+			_stretched_index += from_stretcher;
+			if (from_stretcher == 0 || _stretched_index >= stretched_end) {
+				read_index = last_readable_sample;
+			} else {
+				read_index = std::min<samplepos_t> (last_readable_sample, _stretched_index / _stretched->ratio);
+			}
+		} else if (!do_stretch) {
 			read_index += from_stretcher;
 		}
 
@@ -4873,11 +5484,17 @@ TriggerBoxThread::thread_work ()
 {
 	pthread_set_name (X_("Trigger Worker"));
 
+	bool busy = false;
+
 	while (true) {
 
 		char msg;
 
-		if (_xthread.receive (msg, true) >= 0) {
+		/* do not wait for requests while there are clips to stream,
+		 * or stretches to render
+		 */
+
+		if (_xthread.receive (msg, !busy) >= 0) {
 
 			if (msg == (char) Quit) {
 				return (void *) 0;
@@ -4901,12 +5518,106 @@ TriggerBoxThread::thread_work ()
 				}
 				delete req; /* back to pool */
 			}
+
+			if (msg == (char) ReleaseStretch) {
+				AudioClipData::drop_unused_stretches ();
+			}
 		}
+
+		busy = stream_clips ();
+		busy = render_stretches () || busy;
 	}
 
 	return (void *) 0;
 }
 
+void
+TriggerBoxThread::stream_clip (std::weak_ptr<AudioClipData> clip)
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_stream_lock);
+		_new_streams.push_back (clip);
+	}
+
+	char c = StreamClip;
+	_xthread.deliver (c);
+}
+
+void
+TriggerBoxThread::request_stretch ()
+{
+	char c = RenderStretch;
+	_xthread.deliver (c);
+}
+
+void
+TriggerBoxThread::release_stretch ()
+{
+	char c = ReleaseStretch;
+	_xthread.deliver (c);
+}
+
+bool
+TriggerBoxThread::render_stretches ()
+{
+	std::vector<std::shared_ptr<AudioClipData> > clips (AudioClipData::stretch_requests ());
+
+	/* render the next part of each stretch, round-robin */
+
+	bool more = false;
+
+	for (auto const& clip : clips) {
+		if (clip->render_stretch ()) {
+			more = true;
+		}
+	}
+
+	return more;
+}
+
+bool
+TriggerBoxThread::stream_clips ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_stream_lock);
+		_streams.insert (_streams.end (), _new_streams.begin (), _new_streams.end ());
+		_new_streams.clear ();
+	}
+
+	/* clips that are played close to, or past the data that was read
+	 * so far, come first: a trigger holds playback until it is read.
+	 */
+
+	bool urgent = false;
+
+	for (auto const& s : _streams) {
+		std::shared_ptr<AudioClipData> clip (s.lock ());
+		if (clip && clip->wanted ()) {
+			urgent = true;
+			break;
+		}
+	}
+
+	/* read the next part of each clip, round-robin. Clips that are
+	 * no longer used by any trigger are not read any further.
+	 */
+
+	for (std::vector<std::weak_ptr<AudioClipData> >::iterator i = _streams.begin (); i != _streams.end ();) {
+		std::shared_ptr<AudioClipData> clip (i->lock ());
+		if (clip && urgent && !clip->wanted ()) {
+			++i;
+			continue;
+		}
+		if (!clip || !clip->stream ()) {
+			i = _streams.erase (i);
+		} else {
+			++i;
+		}
+	}
+
+	return !_streams.empty ();
+}
+
 void
 TriggerBoxThread::queue_request (Request* req)
 {
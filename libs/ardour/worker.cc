@@ -17,40 +17,174 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <glibmm/threads.h>
 #include <glibmm/timer.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/compose.h"
+#include "pbd/mpmc_queue.h"
 #include "pbd/pthread_utils.h"
 
+#include "ardour/rc_configuration.h"
 #include "ardour/worker.h"
 
 namespace ARDOUR {
 
+/** Threads that are shared by all threaded Workers.
+ *
+ * A Worker with pending requests is queued once (see Worker::_queued)
+ * and drained by a single pool thread, which preserves the order of its
+ * requests.
+ */
+class WorkerPool
+{
+public:
+	static void attach ();
+	static void detach ();
+
+	/* realtime safe */
+	static bool enqueue (Worker*);
+
+private:
+	WorkerPool (uint32_t n_threads);
+	~WorkerPool ();
+
+	void run ();
+
+	PBD::MPMCQueue<Worker*>   _queue;
+	PBD::Semaphore            _sem;
+	std::vector<PBD::Thread*> _threads;
+	std::atomic<bool>         _exit;
+
+	static WorkerPool*          _instance;
+	static uint32_t             _users;
+	static Glib::Threads::Mutex _instance_lock;
+};
+
+WorkerPool*          WorkerPool::_instance = 0;
+uint32_t             WorkerPool::_users    = 0;
+Glib::Threads::Mutex WorkerPool::_instance_lock;
+
+WorkerPool::WorkerPool (uint32_t n_threads)
+	: _queue (4096)
+	, _sem ("worker_pool", 0)
+{
+	_exit.store (false);
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&WorkerPool::run, this));
+		if (t) {
+			_threads.push_back (t);
+		}
+	}
+	if (_threads.empty ()) {
+		PBD::fatal << "Worker: Cannot create worker threads" << endmsg;
+		abort(); /*NOTREACHED*/
+	}
+}
+
+WorkerPool::~WorkerPool ()
+{
+	_exit.store (true);
+	for (size_t i = 0; i < _threads.size (); ++i) {
+		_sem.signal ();
+	}
+	for (std::vector<PBD::Thread*>::iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+		delete *i;
+	}
+}
+
+void
+WorkerPool::attach ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (_users++ == 0) {
+		/* lv2-worker-threads <= 0: automatic */
+		int32_t n_threads = Config->get_lv2_worker_threads ();
+		if (n_threads <= 0) {
+			n_threads = std::min<uint32_t> (4, hardware_concurrency ());
+		}
+		_instance = new WorkerPool (std::max<int32_t> (1, n_threads));
+	}
+}
+
+void
+WorkerPool::detach ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	assert (_users > 0);
+	if (--_users == 0) {
+		delete _instance;
+		_instance = 0;
+	}
+}
+
+bool
+WorkerPool::enqueue (Worker* w)
+{
+	/* the queue can hold every Worker once, unless there are more than 4096 */
+	if (!_instance->_queue.push_back (w)) {
+		return false;
+	}
+	_instance->_sem.signal ();
+	return true;
+}
+
+void
+WorkerPool::run ()
+{
+	pthread_set_name ("LV2Worker");
+
+	void*  buf      = NULL;
+	size_t buf_size = 0;
+	while (true) {
+		_sem.wait ();
+		if (_exit.load ()) {
+			break;
+		}
+		Worker* w;
+		if (_queue.pop_front (w)) {
+			w->drain (buf, buf_size);
+		}
+	}
+	free (buf);
+}
+
 Worker::Worker(Workee* workee, uint32_t ring_size, bool threaded)
 	: _workee(workee)
 	, _requests(threaded ? new PBD::RingBuffer<uint8_t>(ring_size) : NULL)
 	, _responses(new PBD::RingBuffer<uint8_t>(ring_size))
 	, _response((uint8_t*)malloc(ring_size))
-	, _sem(string_compose ("worker_semaphore%1", this).c_str(), 0)
-	, _thread(NULL)
-	, _exit(false)
 	, _synchronous(!threaded)
 {
+	_queued.store (false);
+	_draining.store (0);
 	if (threaded) {
-		_thread = PBD::Thread::create (boost::bind (&Worker::run, this));
+		WorkerPool::attach ();
 	}
 }
 
 Worker::~Worker()
 {
-	_exit = true;
-	_sem.signal();
-	if (_thread) {
-		_thread->join();
+	if (_requests) {
+		/* Claim the queue-flag, so that this worker cannot be queued
+		 * again, then wait for a pool thread that may still execute
+		 * its work.
+		 */
+		while (_queued.exchange (true)) {
+			Glib::usleep (1000);
+		}
+		while (_draining.load () > 0) {
+			Glib::usleep (1000);
+		}
+		WorkerPool::detach ();
 	}
 	delete _responses;
 	delete _requests;
@@ -74,10 +208,25 @@ Worker::schedule(uint32_t size, const void* data)
 	if (_requests->write((const uint8_t*)data, size) != size) {
 		return false;
 	}
-	_sem.signal();
+	/* The request is in the ring and will be executed, do not report
+	 * failure from here on. If the pool's queue is full, queueing is
+	 * retried by emit_responses () in the next cycle.
+	 */
+	queue ();
 	return true;
 }
 
+void
+Worker::queue ()
+{
+	if (!_queued.exchange (true)) {
+		/* not queued, nor being drained */
+		if (!WorkerPool::enqueue (this)) {
+			_queued.store (false);
+		}
+	}
+}
+
 bool
 Worker::respond(uint32_t size, const void* data)
 {
@@ -119,6 +268,10 @@ Worker::verify_message_completeness(PBD::RingBuffer<uint8_t>* rb)
 void
 Worker::emit_responses()
 {
+	if (_requests && !_synchronous && _requests->read_space () > 0) {
+		queue ();
+	}
+
 	uint32_t read_space = _responses->read_space();
 	uint32_t size       = 0;
 	while (read_space >= sizeof(size)) {
@@ -135,56 +288,56 @@ Worker::emit_responses()
 }
 
 void
-Worker::run()
+Worker::drain(void*& buf, size_t& buf_size)
 {
-	pthread_set_name ("LV2Worker");
+	_draining.fetch_add (1);
 
-	void*  buf      = NULL;
-	size_t buf_size = 0;
 	while (true) {
-		_sem.wait();
-		if (_exit) {
-			free(buf);
-			return;
-		}
+		uint32_t size;
+		while (_requests->read_space() >= sizeof(size)) {
+			if (!verify_message_completeness(_requests)) {
+				/* the audio thread is still writing it */
+				break;
+			}
+			if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
+				PBD::error << "Worker: Error reading size from request ring"
+				           << endmsg;
+				break;
+			}
 
-		uint32_t size = _requests->read_space();
-		if (size < sizeof(size)) {
-			PBD::error << "Worker: no work-data on ring buffer" << endmsg;
-			continue;
-		}
-		while (!verify_message_completeness(_requests)) {
-			Glib::usleep(2000);
-			if (_exit) {
-				if (buf) free(buf);
-				return;
+			if (size > buf_size) {
+				buf = realloc(buf, size);
+				if (buf) {
+					buf_size = size;
+				} else {
+					PBD::fatal << "Worker: Error allocating memory" << endmsg;
+					abort(); /*NOTREACHED*/
+				}
 			}
-		}
-		if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
-			PBD::error << "Worker: Error reading size from request ring"
-			           << endmsg;
-			continue;
-		}
+			assert (buf);
 
-		if (size > buf_size) {
-			buf = realloc(buf, size);
-			if (buf) {
-				buf_size = size;
-			} else {
-				PBD::fatal << "Worker: Error allocating memory" << endmsg;
-				abort(); /*NOTREACHED*/
+			if (_requests->read((uint8_t*)buf, size) < size) {
+				PBD::error << "Worker: Error reading body from request ring"
+				           << endmsg;
+				break;  // TODO: This is probably fatal
 			}
-		}
-		assert (buf);
 
-		if (_requests->read((uint8_t*)buf, size) < size) {
-			PBD::error << "Worker: Error reading body from request ring"
-			           << endmsg;
-			continue;  // TODO: This is probably fatal
+			_workee->work(*this, size, buf);
 		}
 
-		_workee->work(*this, size, buf);
+		/* Allow schedule() to queue this worker again. If a request
+		 * was completed after the ring was found empty, schedule() will
+		 * not have queued it, so continue here unless someone else did.
+		 * A request that is still incomplete now will be queued by
+		 * schedule() once it is written.
+		 */
+		_queued.store (false);
+		if (!verify_message_completeness (_requests) || _queued.exchange (true)) {
+			break;
+		}
 	}
+
+	_draining.fetch_sub (1);
 }
 
 } // namespace ARDOUR
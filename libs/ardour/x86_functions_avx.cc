@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Ardour Community
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+
+/**
+ * @brief x86-64 AVX optimized routine for applying a LPF'ed gain ramp.
+ *
+ * Computes eight consecutive gain coefficients at once, using the closed
+ * form gain[n] = target + (gain - target) * (1 - coeff)^n of the
+ * per-sample recursion gain += coeff * (target - gain).
+ *
+ * @param[in,out] buf Pointer to buffer
+ * @param nframes Number of samples to process
+ * @param gain Initial gain
+ * @param target Target gain
+ * @param coeff Low pass filter coefficient
+ * @return gain reached after @p nframes
+ */
+float
+x86_avx_apply_gain_ramp (float* buf, uint32_t nframes, float gain, float target, float coeff)
+{
+	const float k  = 1.f - coeff;
+	const float k2 = k * k;
+	const float k4 = k2 * k2;
+
+	__m256 vkn = _mm256_set_ps (k4 * k2 * k, k4 * k2, k4 * k, k4, k2 * k, k2, k, 1.f);
+	__m256 vk8 = _mm256_set1_ps (k4 * k4);
+	__m256 vt  = _mm256_set1_ps (target);
+	__m256 vd  = _mm256_set1_ps (gain - target);
+
+	while (nframes >= 8) {
+		__m256 g = _mm256_add_ps (vt, _mm256_mul_ps (vd, vkn));
+		_mm256_storeu_ps (buf, _mm256_mul_ps (g, _mm256_loadu_ps (buf)));
+		vd = _mm256_mul_ps (vd, vk8);
+		buf += 8;
+		nframes -= 8;
+	}
+
+	gain = target + _mm_cvtss_f32 (_mm256_castps256_ps128 (vd));
+
+	while (nframes > 0) {
+		*buf++ *= gain;
+		gain += coeff * (target - gain);
+		--nframes;
+	}
+	return gain;
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for applying a gain vector.
+ *
+ * @param[in,out] buf Pointer to buffer
+ * @param[in] gain Pointer to per-sample gain coefficients
+ * @param nframes Number of samples to process
+ */
+void
+x86_avx_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		__m256 x0 = _mm256_mul_ps (_mm256_loadu_ps (buf + 0), _mm256_loadu_ps (gain + 0));
+		__m256 x1 = _mm256_mul_ps (_mm256_loadu_ps (buf + 8), _mm256_loadu_ps (gain + 8));
+		_mm256_storeu_ps (buf + 0, x0);
+		_mm256_storeu_ps (buf + 8, x1);
+		buf += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	if (nframes >= 8) {
+		_mm256_storeu_ps (buf, _mm256_mul_ps (_mm256_loadu_ps (buf), _mm256_loadu_ps (gain)));
+		buf += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
@@ -2330,16 +2330,16 @@ void*
 AlsaAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		ConnectionList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
+			AlsaAudioPort const* source = static_cast<AlsaAudioPort const*> (it->get ());
 			assert (source && source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
+			while (++it != connections->end ()) {
+				source = static_cast<AlsaAudioPort const*> (it->get ());
 				assert (source && source->is_output ());
 				Sample*       dst = buffer ();
 				const Sample* src = source->const_buffer ();
@@ -2381,11 +2381,11 @@ void* AlsaMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		for (ConnectionList::const_iterator i = connections->begin ();
+		     i != connections->end ();
 		     ++i) {
-			const AlsaMidiBuffer* src = std::dynamic_pointer_cast<const AlsaMidiPort> (*i)->const_buffer ();
+			const AlsaMidiBuffer* src = static_cast<AlsaMidiPort const*> (i->get ())->const_buffer ();
 			for (AlsaMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
@@ -25,6 +25,8 @@
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
+#include "ardour/runtime_functions.h"
+
 #include "alsa_slave.h"
 
 #include "pbd/i18n.h" 
@@ -526,10 +528,7 @@ AlsaAudioSlave::capt_chan (uint32_t chn, float* dst, uint32_t n_samples)
 {
 	uint32_t nchn = _pcmi.ncapt ();
 	assert (chn < nchn && n_samples == _samples_per_period);
-	float* src = &_capt_buff[chn];
-	for (uint32_t s = 0; s < n_samples; ++s) {
-		dst[s] = src[s * nchn];
-	}
+	deinterleave_buffer (dst, &_capt_buff[chn], n_samples, nchn);
 	return n_samples;
 }
 
@@ -541,9 +540,6 @@ AlsaAudioSlave::play_chan (uint32_t chn, float* src, uint32_t n_samples)
 {
 	uint32_t nchn = _pcmi.nplay ();
 	assert (chn < nchn && n_samples == _samples_per_period);
-	float* dst = &_play_buff[chn];
-	for (uint32_t s = 0; s < n_samples; ++s) {
-		dst[s * nchn] = src[s];
-	}
+	interleave_buffer (&_play_buff[chn], src, n_samples, nchn);
 	return n_samples;
 }
@@ -1665,16 +1665,16 @@ void*
 CoreAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		ConnectionList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<const CoreAudioPort> source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
+			CoreAudioPort const* source = static_cast<CoreAudioPort const*>(it->get ());
 			assert (source && source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
+			while (++it != connections->end ()) {
+				source = static_cast<CoreAudioPort const*>(it->get ());
 				assert (source && source->is_output ());
 				Sample* dst = buffer ();
 				const Sample* src = source->const_buffer ();
@@ -1719,11 +1719,11 @@ void* CoreMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		for (ConnectionList::const_iterator i = connections->begin ();
+		     i != connections->end ();
 		     ++i) {
-			const CoreMidiBuffer * src = std::dynamic_pointer_cast<const CoreMidiPort>(*i)->const_buffer ();
+			const CoreMidiBuffer * src = static_cast<CoreMidiPort const*>(i->get ())->const_buffer ();
 			for (CoreMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
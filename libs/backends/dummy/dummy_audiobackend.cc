@@ -19,10 +19,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
 #include <math.h>
 #include <sys/time.h>
 #include <regex.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include <glibmm.h>
 
@@ -59,6 +64,19 @@ static int64_t _x_get_monotonic_usec() {
 	return g_get_monotonic_time();
 }
 
+/* CPU time used by all threads of the process */
+static int64_t _x_get_process_cpu_usec() {
+#ifdef PLATFORM_WINDOWS
+	return -1;
+#else
+	struct timespec ts;
+	if (clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts)) {
+		return -1;
+	}
+	return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+#endif
+}
+
 DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	: AudioBackend (e, info)
 	, PortEngineSharedImpl (e, s_instance_name)
@@ -79,6 +97,9 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	, _systemic_input_latency (0)
 	, _systemic_output_latency (0)
 	, _processed_samples (0)
+	, _bench_wall_usec (0)
+	, _bench_cpu_usec (0)
+	, _bench_n_threads (0)
 {
 	_instance_name = s_instance_name;
 	_device = _("Silence");
@@ -93,8 +114,17 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 		_driver_speed.push_back (DriverSpeed (_("15x Speed"),    0.06666f));
 		_driver_speed.push_back (DriverSpeed (_("20x Speed"),    0.05f));
 		_driver_speed.push_back (DriverSpeed (_("50x Speed"),    0.02f));
+		_driver_speed.push_back (DriverSpeed (_("Benchmark"),    0.0f));
 	}
 
+	/* allow to use benchmark mode with headless tools,
+	 * the value is the path of the report (default: stdout)
+	 */
+	const char* bench = g_getenv ("ARDOUR_DUMMY_BENCHMARK");
+	if (bench) {
+		_speedup = 0;
+		_bench_report_path = bench;
+	}
 }
 
 DummyAudioBackend::~DummyAudioBackend ()
@@ -502,10 +532,65 @@ DummyAudioBackend::stop ()
 		PBD::error << _("DummyAudioBackend: failed to terminate.") << endmsg;
 		return -1;
 	}
+	if (benchmark_mode ()) {
+		benchmark_report ();
+	}
 	unregister_ports();
 	return 0;
 }
 
+void
+DummyAudioBackend::benchmark_report ()
+{
+	if (_bench_cycle_usec.empty ()) {
+		return;
+	}
+
+	std::vector<int32_t> t (_bench_cycle_usec);
+	std::sort (t.begin (), t.end ());
+
+	const size_t  n       = t.size ();
+	const int64_t nominal = _samples_per_period * 1e6 / _samplerate;
+	const double  audio   = n * (double) nominal;
+
+	int64_t sum  = 0;
+	size_t  late = 0;
+	for (std::vector<int32_t>::const_iterator i = t.begin (); i != t.end (); ++i) {
+		sum += *i;
+		if (*i > nominal) {
+			++late;
+		}
+	}
+
+#define PERCENTILE(P) t[std::min (n - 1, (size_t) ((P) * n / 100.0))]
+
+	std::stringstream ss;
+	ss << string_compose ("Dummy backend benchmark: %1 cycles of %2 samples at %3 Hz\n", n, _samples_per_period, _samplerate);
+	ss << string_compose ("wall time: %1 sec, %2x realtime\n", _bench_wall_usec * 1e-6, _bench_wall_usec > 0 ? audio / _bench_wall_usec : 0);
+	ss << string_compose ("cycle [usec]: min %1, p50 %2, p90 %3, p99 %4, p99.9 %5, max %6, mean %7\n",
+	                      t.front (), PERCENTILE (50), PERCENTILE (90), PERCENTILE (99), PERCENTILE (99.9), t.back (), sum / (double) n);
+	ss << string_compose ("nominal period %1 usec, exceeded in %2 cycles (%3%%)\n", nominal, late, 100.0 * late / n);
+
+	/* process CPU time includes the butler and other non-process threads */
+	if (_bench_cpu_usec > 0 && _bench_wall_usec > 0) {
+		const size_t n_threads = 1 + _bench_n_threads;
+		ss << string_compose ("parallel efficiency: %1%% (CPU time / (wall time * %2 process threads))\n",
+		                      100.0 * _bench_cpu_usec / (_bench_wall_usec * (double) n_threads), n_threads);
+	}
+
+#undef PERCENTILE
+
+	if (_bench_report_path.empty ()) {
+		std::cout << ss.str ();
+	} else {
+		std::ofstream f (_bench_report_path.c_str ());
+		f << ss.str ();
+		if (!f) {
+			PBD::error << string_compose (_("DummyAudioBackend: cannot write benchmark report to '%1'"), _bench_report_path) << endmsg;
+		}
+	}
+}
+
 int
 DummyAudioBackend::freewheel (bool onoff)
 {
@@ -574,6 +659,7 @@ DummyAudioBackend::create_process_thread (boost::function<void()> func)
 	}
 
 	_threads.push_back (thread_id);
+	_bench_n_threads = std::max (_bench_n_threads, _threads.size ());
 	return 0;
 }
 
@@ -948,6 +1034,17 @@ DummyAudioBackend::main_process_thread ()
 	PBD::MMTIMERS::set_min_resolution();
 #endif
 
+	const bool benchmark = benchmark_mode ();
+	int64_t    bench_wall_start = -1;
+	int64_t    bench_cpu_start  = -1;
+
+	if (benchmark) {
+		_bench_cycle_usec.clear ();
+		_bench_cycle_usec.reserve (1 << 20);
+		_bench_wall_usec = 0;
+		_bench_cpu_usec  = 0;
+	}
+
 	int64_t clock1;
 	clock1 = -1;
 	while (_running) {
@@ -966,11 +1063,25 @@ DummyAudioBackend::main_process_thread ()
 			std::dynamic_pointer_cast<DummyPort>(*it)->next_period ();
 		}
 
+		const int64_t cycle_start = benchmark ? _x_get_monotonic_usec () : 0;
+
 		if (engine.process_callback (samples_per_period)) {
 			return 0;
 		}
 		_processed_samples += samples_per_period;
 
+		if (benchmark) {
+			const int64_t cycle_end = _x_get_monotonic_usec ();
+			if (bench_wall_start < 0) {
+				bench_wall_start = cycle_start;
+				bench_cpu_start  = _x_get_process_cpu_usec ();
+			}
+			if (_bench_cycle_usec.size () < _bench_cycle_usec.capacity ()) {
+				_bench_cycle_usec.push_back (cycle_end - cycle_start);
+			}
+			_bench_wall_usec = cycle_end - bench_wall_start;
+		}
+
 		if (_device == _("Loopback") && _midi_mode != MidiToAudio) {
 			int opn = 0;
 			int opc = _system_outputs.size();
@@ -1007,7 +1118,9 @@ DummyAudioBackend::main_process_thread ()
 
 			const int64_t elapsed_time = _dsp_load_calc.elapsed_time_us ();
 			const int64_t nominal_time = _dsp_load_calc.get_max_time_us ();
-			if (elapsed_time < nominal_time) {
+			if (benchmark) {
+				/* run the next cycle immediately */
+			} else if (elapsed_time < nominal_time) {
 				const int64_t sleepy = _speedup * (nominal_time - elapsed_time);
 				Glib::usleep (std::max ((int64_t) 10, sleepy));
 			} else {
@@ -1050,6 +1163,9 @@ DummyAudioBackend::main_process_thread ()
 #ifdef PLATFORM_WINDOWS
 	PBD::MMTIMERS::reset_resolution();
 #endif
+	if (benchmark && bench_cpu_start >= 0) {
+		_bench_cpu_usec = _x_get_process_cpu_usec () - bench_cpu_start;
+	}
 	_running = false;
 	return 0;
 }
@@ -1629,19 +1745,19 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		ConnectionList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
+			DummyAudioPort* source = static_cast<DummyAudioPort*>(it->get ());
 			assert (source && source->is_output ());
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
+			while (++it != connections->end ()) {
+				source = static_cast<DummyAudioPort*>(it->get ());
 				assert (source && source->is_output ());
 				Sample* dst = buffer ();
 				if (source->is_physical() && source->is_terminal()) {
@@ -1907,11 +2023,11 @@ void* DummyMidiPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-				i != connections.end ();
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		for (ConnectionList::const_iterator i = connections->begin ();
+				i != connections->end ();
 				++i) {
-			std::shared_ptr<DummyMidiPort> source = std::dynamic_pointer_cast<DummyMidiPort>(*i);
+			DummyMidiPort* source = static_cast<DummyMidiPort*>(i->get ());
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
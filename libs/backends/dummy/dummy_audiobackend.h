@@ -386,6 +386,16 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 
 		samplecnt_t _processed_samples;
 
+		/* benchmark mode: process cycles back to back, report statistics on stop */
+		bool benchmark_mode () const { return _speedup == 0; }
+		void benchmark_report ();
+
+		std::vector<int32_t> _bench_cycle_usec;
+		int64_t              _bench_wall_usec;
+		int64_t              _bench_cpu_usec;
+		size_t               _bench_n_threads;
+		std::string          _bench_report_path;
+
 		pthread_t _main_thread;
 
 		/* process threads */
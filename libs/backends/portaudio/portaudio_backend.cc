@@ -1921,15 +1921,16 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		ConnectionList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
+			PortAudioPort const* source = static_cast<PortAudioPort const*>(it->get ());
 			assert (source && source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
+			while (++it != connections->end ()) {
+				source = static_cast<PortAudioPort const*>(it->get ());
 				assert (source && source->is_output ());
 				Sample* dst = buffer ();
 				const Sample* src = source->const_buffer ();
@@ -1967,10 +1968,11 @@ void* PortMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		for (std::set<BackendPortPtr>::const_iterator i = get_connections ().begin ();
-				i != get_connections ().end ();
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		for (ConnectionList::const_iterator i = connections->begin ();
+				i != connections->end ();
 				++i) {
-			const PortMidiBuffer * src = std::dynamic_pointer_cast<const PortMidiPort>(*i)->const_buffer ();
+			const PortMidiBuffer * src = static_cast<PortMidiPort const*>(i->get ())->const_buffer ();
 			for (PortMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
@@ -1199,17 +1199,17 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		ConnectionList::const_iterator        it          = connections->begin ();
 
-		if (it == connections.end ()) {
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			PulseAudioPort const* source = static_cast<PulseAudioPort const*> (it->get ());
 			assert (source && source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			while (++it != connections->end ()) {
+				source = static_cast<PulseAudioPort const*> (it->get ());
 				assert (source && source->is_output ());
 				Sample*       dst = _buffer;
 				const Sample* src = source->const_buffer ();
@@ -1245,11 +1245,11 @@ void* PulseMidiPort::get_buffer (pframes_t /*n_samples*/)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		std::shared_ptr<ConnectionList const> connections = get_connections ();
+		for (ConnectionList::const_iterator i = connections->begin ();
+		     i != connections->end ();
 		     ++i) {
-			const PulseMidiBuffer* src = std::dynamic_pointer_cast<PulseMidiPort> (*i)->const_buffer ();
+			const PulseMidiBuffer* src = static_cast<PulseMidiPort const*> (i->get ())->const_buffer ();
 			for (PulseMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				_buffer.push_back (*it);
 			}
@@ -79,6 +79,8 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc,
 	_search_cache.left          = timepos_t::max (time_domain());
 	_search_cache.first         = _events.end ();
 	_sort_pending               = false;
+	_eval_index_valid           = false;
+	_use_eval_index             = true;
 	new_write_pass              = true;
 	_in_write_pass              = false;
 	did_write_during_pass       = false;
@@ -99,6 +101,8 @@ ControlList::ControlList (const ControlList& other)
 	_lookup_cache.range.second  = _events.end ();
 	_search_cache.first         = _events.end ();
 	_sort_pending               = false;
+	_eval_index_valid           = false;
+	_use_eval_index             = other._use_eval_index;
 	new_write_pass              = true;
 	_in_write_pass              = false;
 	did_write_during_pass       = false;
@@ -122,6 +126,9 @@ ControlList::ControlList (const ControlList& other, timepos_t const& start, time
 	_lookup_cache.range.second = _events.end ();
 	_search_cache.first        = _events.end ();
 	_sort_pending              = false;
+	_eval_index_valid          = false;
+	_use_eval_index            = other._use_eval_index;
+	_in_write_pass             = false;
 
 	/* now grab the relevant points, and shift them back if necessary */
 
@@ -238,10 +245,47 @@ ControlList::maybe_signal_changed ()
 	if (_frozen) {
 		_changed_when_thawed = true;
 	} else {
+		update_eval_index ();
 		Dirty (); /* EMIT SIGNAL */
 	}
 }
 
+void
+ControlList::set_use_eval_index (bool yn)
+{
+	{
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		_use_eval_index   = yn;
+		_eval_index_valid = false;
+		if (!yn) {
+			EvalIndex ().swap (_eval_index);
+		}
+	}
+	update_eval_index ();
+}
+
+/** Rebuild the contiguous copy of the event list used by indexed_eval().
+ * Must not be called with _lock held.
+ */
+void
+ControlList::update_eval_index ()
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+
+	if (_eval_index_valid || !_use_eval_index || _frozen || _sort_pending || _in_write_pass) {
+		return;
+	}
+
+	_eval_index.clear ();
+	_eval_index.reserve (_events.size ());
+
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i) {
+		_eval_index.push_back (EvalPoint ((*i)->when, (*i)->value));
+	}
+
+	_eval_index_valid = true;
+}
+
 void
 ControlList::clear ()
 {
@@ -548,6 +592,9 @@ ControlList::write_pass_finished (timepos_t const& /*when*/, double thinning_fac
 	}
 	new_write_pass = true;
 	_in_write_pass = false;
+
+	/* adding points does not update the index during the pass */
+	update_eval_index ();
 }
 
 void
@@ -1321,6 +1368,7 @@ ControlList::thaw ()
 void
 ControlList::mark_dirty () const
 {
+	_eval_index_valid          = false;
 	_lookup_cache.left         = timepos_t::max (time_domain());
 	_lookup_cache.range.first  = _events.end ();
 	_lookup_cache.range.second = _events.end ();
@@ -1605,6 +1653,10 @@ ControlList::multipoint_eval (timepos_t const& xtime) const
 	double    uval, lval;
 	double    fraction;
 
+	if (_eval_index_valid) {
+		return indexed_eval (xtime);
+	}
+
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
@@ -1681,6 +1733,44 @@ ControlList::multipoint_eval (timepos_t const& xtime) const
 	return (*range.first)->value;
 }
 
+/** Same as multipoint_eval(), using a binary search over _eval_index.
+ * Since no lookup-cache is involved, concurrent readers do not interfere.
+ */
+double
+ControlList::indexed_eval (timepos_t const& xtime) const
+{
+	/* first point at or after xtime. multipoint_eval() is only called for
+	 * front < xtime < back, so there is always a point before and after */
+	EvalIndex::const_iterator u = lower_bound (_eval_index.begin (), _eval_index.end (), xtime, EvalPoint::time_less_than);
+
+	assert (u != _eval_index.begin () && u != _eval_index.end ());
+
+	if (u->when == xtime) {
+		/* x is a control point in the data */
+		return u->value;
+	}
+
+	EvalIndex::const_iterator l = u - 1;
+
+	if (_interpolation == Discrete) {
+		return l->value;
+	}
+
+	const double fraction = (double)l->when.distance (xtime).distance ().val () / (double)l->when.distance (u->when).distance ().val ();
+
+	switch (_interpolation) {
+		case Logarithmic:
+			return interpolate_logarithmic (l->value, u->value, fraction, _desc.lower, _desc.upper);
+		case Exponential:
+			return interpolate_gain (l->value, u->value, fraction, _desc.upper);
+		case Curved:
+			/* only used x-fade curves, never direct eval */
+			assert (0);
+		default: // Linear
+			return interpolate_linear (l->value, u->value, fraction);
+	}
+}
+
 void
 ControlList::build_search_cache_if_necessary (timepos_t const& start_time) const
 {
@@ -2268,6 +2358,7 @@ ControlList::finish_domain_bounce (Temporal::DomainBounceInfo& dbi)
 			t.set_time_domain (dbi.from);
 			e->when = t;
 		}
+		mark_dirty ();
 	}
 
 	maybe_signal_changed ();
@@ -478,6 +478,8 @@ Sequence<Time>::Sequence(const TypeMap& type_map)
 	, _overlapping_pitches_accepted (true)
 	, _overlap_pitch_resolution (FirstOnFirstOff)
 	, _writing(false)
+	, _note_index_dirty (true)
+	, _use_note_index (true)
 	, _type_map(type_map)
 	, _end_iter(*this, std::numeric_limits<Time>::max(), false, std::set<Evoral::Parameter> ())
 	, _lowest_note(127)
@@ -499,6 +501,8 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _overlapping_pitches_accepted (other._overlapping_pitches_accepted)
 	, _overlap_pitch_resolution (other._overlap_pitch_resolution)
 	, _writing(false)
+	, _note_index_dirty (true)
+	, _use_note_index (other._use_note_index)
 	, _type_map(other._type_map)
 	, _end_iter(*this, std::numeric_limits<Time>::max(), false, std::set<Evoral::Parameter> ())
 	, _lowest_note(other._lowest_note)
@@ -624,6 +628,7 @@ Sequence<Time>::clear()
 {
 	WriteLock lock(write_lock());
 	_notes.clear();
+	_note_index_dirty = true;
 	_sysexes.clear ();
 	_patch_changes.clear ();
 	for (Controls::iterator li = _controls.begin(); li != _controls.end(); ++li)
@@ -698,6 +703,8 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 		_write_notes[i].clear();
 	}
 
+	/* note-offs set the length of notes while writing */
+	_note_index_dirty = true;
 	_writing = false;
 }
 
@@ -727,6 +734,7 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 
 	_notes.insert (note);
 	_pitches[note->channel()].insert (note);
+	_note_index_dirty = true;
 
 	_edited = true;
 
@@ -757,6 +765,7 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 			_notes.erase (i);
+			_note_index_dirty = true;
 
 			if (note->note() == _lowest_note || note->note() == _highest_note) {
 
@@ -797,6 +806,7 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 				DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\tID-based pass, erasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 				_notes.erase (i);
+				_note_index_dirty = true;
 
 				if (note->note() == _lowest_note || note->note() == _highest_note) {
 
@@ -1058,6 +1068,7 @@ Sequence<Time>::append_note_off_unlocked (const Event<Time>& ev)
 
 			nn->set_length (ev.time() - nn->time());
 			nn->set_off_velocity (ev.velocity());
+			_note_index_dirty = true;
 
 			_write_notes[ev.channel()].erase(n);
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("resolved note @ %2 length: %1\n", nn->length(), nn->time()));
@@ -1186,25 +1197,18 @@ Sequence<Time>::overlaps_unlocked (const NotePtr& note, const NotePtr& without)
 	Time sa = note->time();
 	Time ea  = note->end_time();
 
-	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	/* any note of the same channel and pitch with sb <= ea && eb >= sa */
+	std::vector<NotePtr> found;
+	get_notes_overlapping_unlocked (found, sa, ea, 1 << note->channel());
 
-	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
-
-		if (without && (**i) == *without) {
+	for (typename std::vector<NotePtr>::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if ((*i)->note() != note->note()) {
 			continue;
 		}
-
-		Time sb = (*i)->time();
-		Time eb = (*i)->end_time();
-
-		if (((sb > sa) && (eb <= ea)) ||
-		    ((eb >= sa) && (eb <= ea)) ||
-		    ((sb > sa) && (sb <= ea)) ||
-		    ((sa >= sb) && (sa <= eb) && (ea <= eb))) {
-			return true;
+		if (without && (**i) == *without) {
+			continue;
 		}
+		return true;
 	}
 
 	return false;
@@ -1215,6 +1219,7 @@ void
 Sequence<Time>::set_notes (const typename Sequence<Time>::Notes& n)
 {
 	_notes = n;
+	_note_index_dirty = true;
 }
 
 // CONST iterator implementations (x3)
@@ -1322,43 +1327,39 @@ Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int
 
 		const Pitches& p (pitches (c));
 		NotePtr search_note(new Note<Time>(0, Time(), Time(), val, 0));
-		typename Pitches::const_iterator i;
+		typename Pitches::const_iterator b;
+		typename Pitches::const_iterator e;
+		/* Pitches are sorted by note number, so each operator is a range */
 		switch (op) {
 		case PitchEqual:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() == val) {
-				n.insert (*i);
-			}
+			b = p.lower_bound (search_note);
+			e = p.upper_bound (search_note);
 			break;
 		case PitchLessThan:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() < val) {
-				n.insert (*i);
-			}
+			b = p.begin ();
+			e = p.lower_bound (search_note);
 			break;
 		case PitchLessThanOrEqual:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() <= val) {
-				n.insert (*i);
-			}
+			b = p.begin ();
+			e = p.upper_bound (search_note);
 			break;
 		case PitchGreater:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() > val) {
-				n.insert (*i);
-			}
+			b = p.upper_bound (search_note);
+			e = p.end ();
 			break;
 		case PitchGreaterThanOrEqual:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() >= val) {
-				n.insert (*i);
-			}
+			b = p.lower_bound (search_note);
+			e = p.end ();
 			break;
 
 		default:
 			//fatal << string_compose (_("programming error: %1 %2", X_("get_notes_by_pitch() called with illegal operator"), op)) << endmsg;
 			abort(); /* NOTREACHED*/
 		}
+
+		for (; b != e; ++b) {
+			n.insert (*b);
+		}
 	}
 }
 
@@ -1408,6 +1409,193 @@ Sequence<Time>::get_notes_by_velocity (Notes& n, NoteOperator op, uint8_t val, i
 	}
 }
 
+template<typename Time>
+void
+Sequence<Time>::get_notes_at (Notes& n, Time t, int chan_mask) const
+{
+	NoteQuery q;
+	q.start           = t;
+	q.end             = t;
+	q.start_inclusive = false;
+	q.end_inclusive   = true;
+	q.chan_mask       = chan_mask;
+
+	std::vector<NotePtr> found;
+	{
+		ReadLock lock (read_lock());
+		find_notes (found, q);
+	}
+
+	for (typename std::vector<NotePtr>::const_iterator i = found.begin(); i != found.end(); ++i) {
+		n.insert (n.end(), *i);
+	}
+}
+
+template<typename Time>
+void
+Sequence<Time>::get_notes_in_range (Notes& n, Time start, Time end, int chan_mask) const
+{
+	NoteQuery q;
+	q.start           = start;
+	q.end             = end;
+	q.start_inclusive = false;
+	q.end_inclusive   = false;
+	q.chan_mask       = chan_mask;
+
+	std::vector<NotePtr> found;
+	{
+		ReadLock lock (read_lock());
+		find_notes (found, q);
+	}
+
+	for (typename std::vector<NotePtr>::const_iterator i = found.begin(); i != found.end(); ++i) {
+		n.insert (n.end(), *i);
+	}
+}
+
+template<typename Time>
+void
+Sequence<Time>::get_notes_overlapping_unlocked (std::vector<NotePtr>& found, Time start, Time end, int chan_mask) const
+{
+	NoteQuery q;
+	q.start           = start;
+	q.end             = end;
+	q.start_inclusive = true;
+	q.end_inclusive   = true;
+	q.chan_mask       = chan_mask;
+
+	find_notes (found, q);
+}
+
+template<typename Time>
+void
+Sequence<Time>::set_use_note_index (bool yn)
+{
+	Glib::Threads::Mutex::Lock lm (_note_index_lock);
+	_use_note_index = yn;
+	_note_index_dirty = true;
+	if (!yn) {
+		_note_index.clear ();
+		_note_index_start.clear ();
+		_note_index_end.clear ();
+		_note_index_max_end.clear ();
+	}
+}
+
+/** Find notes matching \p q, in time order. The caller must hold the read lock. */
+template<typename Time>
+void
+Sequence<Time>::find_notes (std::vector<NotePtr>& found, NoteQuery const& q) const
+{
+	if (!_use_note_index) {
+		for (typename Notes::const_iterator i = _notes.begin(); i != _notes.end(); ++i) {
+			Time const s = (*i)->time();
+			if (q.end_inclusive ? s > q.end : s >= q.end) {
+				break;
+			}
+			Time const e = (*i)->end_time();
+			if (q.start_inclusive ? e < q.start : e <= q.start) {
+				continue;
+			}
+			if (q.chan_mask != 0 && !((1 << (*i)->channel()) & q.chan_mask)) {
+				continue;
+			}
+			found.push_back (*i);
+		}
+		return;
+	}
+
+	/* concurrent readers may query (and rebuild) the index */
+	Glib::Threads::Mutex::Lock lm (_note_index_lock);
+
+	if (_note_index_dirty) {
+		rebuild_note_index ();
+	}
+
+	query_note_index (found, q, 0, _note_index.size ());
+}
+
+template<typename Time>
+void
+Sequence<Time>::rebuild_note_index () const
+{
+	size_t const n = _notes.size ();
+
+	_note_index.clear ();
+	_note_index_start.clear ();
+	_note_index_end.clear ();
+	_note_index_max_end.resize (n);
+
+	_note_index.reserve (n);
+	_note_index_start.reserve (n);
+	_note_index_end.reserve (n);
+
+	for (typename Notes::const_iterator i = _notes.begin(); i != _notes.end(); ++i) {
+		_note_index.push_back (*i);
+		_note_index_start.push_back ((*i)->time());
+		_note_index_end.push_back ((*i)->end_time());
+	}
+
+	if (n > 0) {
+		build_note_index (0, n);
+	}
+
+	_note_index_dirty = false;
+}
+
+/** Fill in the subtree maxima for the (non empty) range [b, e), and return it */
+template<typename Time>
+Time
+Sequence<Time>::build_note_index (size_t b, size_t e) const
+{
+	size_t const m = b + (e - b) / 2;
+
+	Time max_end = _note_index_end[m];
+
+	if (b < m) {
+		max_end = std::max (max_end, build_note_index (b, m));
+	}
+	if (m + 1 < e) {
+		max_end = std::max (max_end, build_note_index (m + 1, e));
+	}
+
+	_note_index_max_end[m] = max_end;
+	return max_end;
+}
+
+template<typename Time>
+void
+Sequence<Time>::query_note_index (std::vector<NotePtr>& found, NoteQuery const& q, size_t b, size_t e) const
+{
+	if (b >= e) {
+		return;
+	}
+
+	size_t const m = b + (e - b) / 2;
+
+	/* no note in this range ends late enough */
+	Time const max_end = _note_index_max_end[m];
+	if (q.start_inclusive ? max_end < q.start : max_end <= q.start) {
+		return;
+	}
+
+	query_note_index (found, q, b, m);
+
+	/* notes are sorted by start, none at or after m starts early enough */
+	Time const s = _note_index_start[m];
+	if (q.end_inclusive ? s > q.end : s >= q.end) {
+		return;
+	}
+
+	Time const en = _note_index_end[m];
+	if ((q.start_inclusive ? en >= q.start : en > q.start)
+	    && (q.chan_mask == 0 || ((1 << _note_index[m]->channel()) & q.chan_mask))) {
+		found.push_back (_note_index[m]);
+	}
+
+	query_note_index (found, q, m + 1, e);
+}
+
 template<typename Time>
 void
 Sequence<Time>::set_overlap_pitch_resolution (OverlapPitchResolution opr)
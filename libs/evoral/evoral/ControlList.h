@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -286,6 +287,14 @@ public:
 		return a->when < b->when;
 	}
 
+	/** Evaluate using a contiguous copy of the event list (binary search
+	 * over an array instead of walking the list). The copy is refreshed
+	 * when a change is signalled, but not during a write pass, in which case
+	 * evaluation falls back to the event list. Enabled by default.
+	 */
+	void set_use_eval_index (bool yn);
+	bool use_eval_index () const { return _use_eval_index; }
+
 	/** Lookup cache for eval functions, range contains equivalent values */
 	struct LookupCache {
 		LookupCache() : left (std::numeric_limits<Temporal::timepos_t>::max()) {}
@@ -379,6 +388,9 @@ public:
 
 	/** Called by unlocked_eval() to handle cases of 3 or more control points. */
 	double multipoint_eval (Temporal::timepos_t const & x) const;
+	double indexed_eval (Temporal::timepos_t const & x) const;
+
+	void update_eval_index ();
 
 	void build_search_cache_if_necessary (Temporal::timepos_t const & start) const;
 
@@ -396,6 +408,19 @@ public:
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
 
+	struct EvalPoint {
+		EvalPoint (Temporal::timepos_t const & w, double v) : when (w), value (v) {}
+		static bool time_less_than (EvalPoint const & p, Temporal::timepos_t const & t) { return p.when < t; }
+		Temporal::timepos_t when;
+		double              value;
+	};
+
+	typedef std::vector<EvalPoint> EvalIndex;
+
+	EvalIndex             _eval_index;
+	mutable bool          _eval_index_valid;
+	bool                  _use_eval_index;
+
 	mutable Glib::Threads::RWLock _lock;
 
 	Parameter             _parameter;
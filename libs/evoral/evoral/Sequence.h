@@ -155,7 +155,7 @@ public:
 	};
 
 	typedef std::multiset<NotePtr, EarlierNoteComparator> Notes;
-	inline       Notes& notes()       { return _notes; }
+	inline       Notes& notes()       { _note_index_dirty = true; return _notes; }
 	inline const Notes& notes() const { return _notes; }
 
 	enum NoteOperator {
@@ -173,6 +173,25 @@ public:
 
 	void get_notes (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 
+	/** Notes that are sounding at time \p t: start <= t < end */
+	void get_notes_at (Notes&, Time t, int chan_mask = 0) const;
+
+	/** Notes that overlap the range [\p start, \p end) */
+	void get_notes_in_range (Notes&, Time start, Time end, int chan_mask = 0) const;
+
+	/** Time based note queries use an interval index over all notes,
+	 * which is rebuilt on demand after the notes changed. Use a linear
+	 * scan of the notes instead if \p yn is false.
+	 */
+	void set_use_note_index (bool yn);
+	bool use_note_index () const { return _use_note_index; }
+
+	/** The note index can not see changes to the time or length of notes
+	 * that are part of the sequence. Call this after modifying a note in
+	 * place.
+	 */
+	void invalidate_note_index () { _note_index_dirty = true; }
+
 	void remove_overlapping_notes ();
 	void trim_overlapping_notes ();
 	void remove_duplicate_notes ();
@@ -332,6 +351,11 @@ protected:
 	inline       Pitches& pitches(uint8_t chan)       { return _pitches[chan&0xf]; }
 	inline const Pitches& pitches(uint8_t chan) const { return _pitches[chan&0xf]; }
 
+	/** Notes that overlap the closed range [\p start, \p end], in time order.
+	 * The caller must hold the read or write lock.
+	 */
+	void get_notes_overlapping_unlocked (std::vector<NotePtr>&, Time start, Time end, int chan_mask = 0) const;
+
 	virtual void control_list_marked_dirty ();
 
 private:
@@ -349,6 +373,32 @@ private:
 	void get_notes_by_pitch (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 	void get_notes_by_velocity (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 
+	/* Interval index: _notes in time order, with start and end time
+	 * copied for cache-friendly access. _note_index_max_end is an
+	 * implicit balanced tree: the node of the index range [b, e) is
+	 * its middle element, which stores the latest end time of the range.
+	 */
+	struct NoteQuery {
+		Time start;
+		Time end;
+		bool start_inclusive; // match notes ending at start
+		bool end_inclusive;   // match notes starting at end
+		int  chan_mask;
+	};
+
+	void find_notes (std::vector<NotePtr>&, NoteQuery const&) const;
+	void rebuild_note_index () const;
+	Time build_note_index (size_t b, size_t e) const;
+	void query_note_index (std::vector<NotePtr>&, NoteQuery const&, size_t b, size_t e) const;
+
+	mutable std::vector<NotePtr> _note_index;
+	mutable std::vector<Time>    _note_index_start;
+	mutable std::vector<Time>    _note_index_end;
+	mutable std::vector<Time>    _note_index_max_end;
+	mutable bool                 _note_index_dirty;
+	mutable Glib::Threads::Mutex _note_index_lock;
+	bool                         _use_note_index;
+
 	const TypeMap& _type_map;
 
 	Notes        _notes;       // notes indexed by time
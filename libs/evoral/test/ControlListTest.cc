@@ -0,0 +1,76 @@
+#include "ControlListTest.h"
+#include "evoral/ControlList.h"
+#include <inttypes.h>
+#include <stdlib.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ControlListTest);
+
+using namespace Evoral;
+using namespace Temporal;
+
+/* compare evaluation with and without the contiguous eval-index */
+static void
+compare_eval (ControlList const& a, ControlList const& b, samplepos_t end)
+{
+	for (samplepos_t s = -10; s < end + 10; s += 7) {
+		char msg[64];
+		snprintf (msg, 64, "at sample %" PRId64, s);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE (msg, b.eval (timepos_t (s)), a.eval (timepos_t (s)));
+	}
+}
+
+void
+ControlListTest::indexedEval ()
+{
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	std::shared_ptr<Evoral::ControlList> ref = TestCtrlList();
+
+	ref->set_use_eval_index (false);
+	CPPUNIT_ASSERT (cl->use_eval_index ());
+	CPPUNIT_ASSERT (!ref->use_eval_index ());
+
+	srand (42);
+
+	cl->freeze ();
+	ref->freeze ();
+	for (samplepos_t s = 0; s < 10000; s += 1 + rand () % 50) {
+		double v = rand () / (double) RAND_MAX;
+		cl->fast_simple_add (timepos_t (s), v);
+		ref->fast_simple_add (timepos_t (s), v);
+	}
+	cl->thaw ();
+	ref->thaw ();
+
+	cl->set_interpolation (ControlList::Linear);
+	ref->set_interpolation (ControlList::Linear);
+	compare_eval (*cl, *ref, 10000);
+
+	cl->set_interpolation (ControlList::Discrete);
+	ref->set_interpolation (ControlList::Discrete);
+	compare_eval (*cl, *ref, 10000);
+}
+
+void
+ControlListTest::indexedEvalAfterEdit ()
+{
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	cl->set_interpolation (ControlList::Linear);
+
+	cl->freeze ();
+	cl->fast_simple_add (timepos_t (0), 0.0);
+	cl->fast_simple_add (timepos_t (100), 1.0);
+	cl->fast_simple_add (timepos_t (200), 0.0);
+	cl->thaw ();
+
+	CPPUNIT_ASSERT_EQUAL (0.5, cl->eval (timepos_t (50)));
+
+	cl->editor_add (timepos_t (50), 0.0, false);
+	CPPUNIT_ASSERT_EQUAL (0.0, cl->eval (timepos_t (50)));
+	CPPUNIT_ASSERT_EQUAL (0.5, cl->eval (timepos_t (75)));
+
+	cl->modify (++cl->begin (), timepos_t (50), 1.0);
+	CPPUNIT_ASSERT_EQUAL (1.0, cl->eval (timepos_t (75)));
+
+	cl->erase (++cl->begin ());
+	CPPUNIT_ASSERT_EQUAL (0.5, cl->eval (timepos_t (50)));
+}
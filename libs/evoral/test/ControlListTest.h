@@ -0,0 +1,25 @@
+#include <memory>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "evoral/ControlList.h"
+
+class ControlListTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (ControlListTest);
+	CPPUNIT_TEST (indexedEval);
+	CPPUNIT_TEST (indexedEvalAfterEdit);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void indexedEval ();
+	void indexedEvalAfterEdit ();
+
+private:
+	std::shared_ptr<Evoral::ControlList> TestCtrlList() {
+		Evoral::Parameter param (Evoral::Parameter(0));
+		const Evoral::ParameterDescriptor desc;
+		return std::shared_ptr<Evoral::ControlList> (new Evoral::ControlList(param, desc, Temporal::TimeDomainProvider (Temporal::AudioTime)));
+	}
+};
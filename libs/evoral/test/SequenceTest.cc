@@ -1,5 +1,7 @@
 #include "SequenceTest.h"
 #include <cassert>
+#include <cstdlib>
+#include <set>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SequenceTest);
 
@@ -195,3 +197,115 @@ SequenceTest::controlInterpolationTest ()
 		last_value = i->second;
 	}
 }
+
+void
+SequenceTest::notesByPitchTest ()
+{
+	typedef Sequence<Time>::Notes SeqNotes;
+
+	/* channel 0: 60, 62, 62, 64; channel 1: 62 */
+	uint8_t const pitch[] = { 60, 62, 62, 64, 62 };
+	for (int i = 0; i < 5; ++i) {
+		std::shared_ptr<Note<Time> > note (new Note<Time> (i == 4 ? 1 : 0, Time::ticks (i * 1920), Time::ticks (960), pitch[i], 64));
+		seq->add_note_unlocked (note);
+	}
+
+	SeqNotes n;
+	seq->get_notes (n, Sequence<Time>::PitchEqual, 62, 1);
+	CPPUNIT_ASSERT_EQUAL (size_t (2), n.size ());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchEqual, 62);
+	CPPUNIT_ASSERT_EQUAL (size_t (3), n.size ());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchLessThan, 62);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), n.size ());
+	CPPUNIT_ASSERT_EQUAL (uint8_t (60), (*n.begin ())->note ());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchLessThanOrEqual, 62, 1);
+	CPPUNIT_ASSERT_EQUAL (size_t (3), n.size ());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchGreater, 62);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), n.size ());
+	CPPUNIT_ASSERT_EQUAL (uint8_t (64), (*n.begin ())->note ());
+
+	n.clear ();
+	seq->get_notes (n, Sequence<Time>::PitchGreaterThanOrEqual, 62);
+	CPPUNIT_ASSERT_EQUAL (size_t (4), n.size ());
+}
+
+/* add random, overlapping notes; times in ticks */
+static void
+add_random_notes (MySequence<Temporal::Beats>& seq, int n_notes, int spacing, int max_length)
+{
+	for (int i = 0; i < n_notes; ++i) {
+		std::shared_ptr<Note<Temporal::Beats> > note (
+			new Note<Temporal::Beats> (rand () % 16,
+			                           Temporal::Beats::ticks (i * spacing),
+			                           Temporal::Beats::ticks (rand () % max_length),
+			                           rand () % 128, 64));
+		seq.add_note_unlocked (note);
+	}
+}
+
+static bool
+same_notes (Sequence<Temporal::Beats>::Notes const& a, Sequence<Temporal::Beats>::Notes const& b)
+{
+	if (a.size () != b.size ()) {
+		return false;
+	}
+	std::set<std::shared_ptr<Note<Temporal::Beats> > > sa (a.begin (), a.end ());
+	for (Sequence<Temporal::Beats>::Notes::const_iterator i = b.begin (); i != b.end (); ++i) {
+		if (sa.find (*i) == sa.end ()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+SequenceTest::noteIndexTest ()
+{
+	typedef Sequence<Time>::Notes SeqNotes;
+
+	srand (42);
+	add_random_notes (*seq, 2000, 48, 4 * 1920);
+	int64_t const extent = 2000 * 48 + 4 * 1920;
+
+	for (int i = 0; i < 500; ++i) {
+		Time const t = Time::ticks (rand () % extent);
+		Time const e = t + Time::ticks (rand () % 1920);
+		int const  mask = (i % 2) ? 0 : (1 << (rand () % 16));
+
+		SeqNotes at_idx, at_lin, range_idx, range_lin;
+
+		seq->set_use_note_index (true);
+		seq->get_notes_at (at_idx, t, mask);
+		seq->get_notes_in_range (range_idx, t, e, mask);
+
+		seq->set_use_note_index (false);
+		seq->get_notes_at (at_lin, t, mask);
+		seq->get_notes_in_range (range_lin, t, e, mask);
+
+		CPPUNIT_ASSERT (same_notes (at_idx, at_lin));
+		CPPUNIT_ASSERT (same_notes (range_idx, range_lin));
+
+		for (SeqNotes::const_iterator n = at_idx.begin (); n != at_idx.end (); ++n) {
+			CPPUNIT_ASSERT ((*n)->time () <= t && (*n)->end_time () > t);
+		}
+	}
+
+	/* editing a note in place invalidates the index */
+	seq->set_use_note_index (true);
+	std::shared_ptr<Note<Time> > note = *seq->notes ().begin ();
+	SeqNotes before;
+	seq->get_notes_at (before, note->time (), 1 << note->channel ());
+	note->set_length (Time::ticks (extent));
+	seq->invalidate_note_index ();
+	SeqNotes after;
+	seq->get_notes_at (after, Time::ticks (extent - 1), 1 << note->channel ());
+	CPPUNIT_ASSERT (after.find (note) != after.end ());
+}
@@ -0,0 +1,57 @@
+#include <cstdlib>
+#include <iostream>
+
+#include <glib.h>
+
+#include "SequenceTest.h"
+
+/* Time based note queries on a dense sequence, using the note index
+ * and a linear scan of all notes.
+ *
+ * This is not part of the unit tests, run it manually:
+ *   note-queries [n-notes] [n-queries]
+ */
+
+typedef Temporal::Beats Time;
+
+int
+main (int argc, char* argv[])
+{
+	typedef Sequence<Time>::Notes SeqNotes;
+
+	int const n_notes   = argc > 1 ? atoi (argv[1]) : 100000;
+	int const n_queries = argc > 2 ? atoi (argv[2]) : 2000;
+
+	DummyTypeMap     type_map;
+	MySequence<Time> seq (type_map);
+
+	srand (1);
+	for (int i = 0; i < n_notes; ++i) {
+		std::shared_ptr<Note<Time> > note (
+			new Note<Time> (rand () % 16, Time::ticks (i * 10), Time::ticks (rand () % (4 * 1920)), rand () % 128, 64));
+		seq.add_note_unlocked (note);
+	}
+	int64_t const extent = (int64_t) n_notes * 10;
+
+	for (int use_index = 1; use_index >= 0; --use_index) {
+		seq.set_use_note_index (use_index);
+
+		size_t  n  = 0;
+		int64_t t0 = g_get_monotonic_time ();
+		srand (2);
+		for (int i = 0; i < n_queries; ++i) {
+			Time const t = Time::ticks (rand () % extent);
+			SeqNotes at;
+			SeqNotes range;
+			seq.get_notes_at (at, t);
+			seq.get_notes_in_range (range, t, t + Time::ticks (1920));
+			n += at.size () + range.size ();
+		}
+		int64_t t1 = g_get_monotonic_time ();
+
+		std::cout << "Sequence note queries (" << n_notes << " notes, " << (use_index ? "index" : "linear")
+		          << "): " << (t1 - t0) / (double) n_queries << " usec/query [" << n << "]" << std::endl;
+	}
+
+	return 0;
+}
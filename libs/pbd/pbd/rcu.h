@@ -258,6 +258,25 @@ public:
 		_dead_wood.clear ();
 	}
 
+	/* drop old values that are no longer referenced by any reader, without
+	 * making a copy. Unlike flush(), values that are still in use are kept,
+	 * so a reader never drops the last reference to an old value.
+	 */
+	void cleanup ()
+	{
+		std::lock_guard<std::mutex> lm (_lock);
+
+		typename std::list<std::shared_ptr<T> >::iterator i;
+
+		for (i = _dead_wood.begin (); i != _dead_wood.end ();) {
+			if ((*i).unique ()) {
+				i = _dead_wood.erase (i);
+			} else {
+				++i;
+			}
+		}
+	}
+
 private:
 	std::mutex                             _lock;
 	typename RCUManager<T>::PtrToSharedPtr _current_write_old;
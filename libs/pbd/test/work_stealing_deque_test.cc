@@ -0,0 +1,125 @@
+#include <pthread.h>
+
+#include "work_stealing_deque_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WorkStealingDequeTest);
+
+using namespace std;
+
+#define N_ITEMS   (100000)
+#define N_THIEVES (3)
+
+void
+WorkStealingDequeTest::single_thread ()
+{
+	PBD::WorkStealingDeque<intptr_t> d (4);
+	CPPUNIT_ASSERT_EQUAL ((size_t)4, d.capacity ());
+
+	for (intptr_t i = 1; i <= 4; ++i) {
+		CPPUNIT_ASSERT (d.push_back (i));
+	}
+	/* full */
+	CPPUNIT_ASSERT (!d.push_back (5));
+	CPPUNIT_ASSERT_EQUAL ((size_t)4, d.size ());
+
+	intptr_t v;
+	/* owner is LIFO */
+	CPPUNIT_ASSERT (d.pop_back (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)4, v);
+	/* thieves are FIFO */
+	CPPUNIT_ASSERT (d.steal (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)1, v);
+	CPPUNIT_ASSERT (d.pop_back (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)3, v);
+	CPPUNIT_ASSERT (d.pop_back (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)2, v);
+
+	CPPUNIT_ASSERT (!d.pop_back (v));
+	CPPUNIT_ASSERT (!d.steal (v));
+	CPPUNIT_ASSERT_EQUAL ((size_t)0, d.size ());
+
+	/* indices keep moving, the ring wraps */
+	for (intptr_t i = 0; i < 10; ++i) {
+		CPPUNIT_ASSERT (d.push_back (i));
+		CPPUNIT_ASSERT (d.steal (v));
+		CPPUNIT_ASSERT_EQUAL (i, v);
+	}
+}
+
+static void*
+launch_owner (void* self)
+{
+	static_cast<WorkStealingDequeTest*> (self)->owner_thread ();
+	return NULL;
+}
+
+static void*
+launch_thief (void* self)
+{
+	static_cast<WorkStealingDequeTest*> (self)->thief_thread ();
+	return NULL;
+}
+
+void
+WorkStealingDequeTest::race ()
+{
+	_deque.reserve (64);
+	_seen = vector<std::atomic<int> > (N_ITEMS);
+	for (int i = 0; i < N_ITEMS; ++i) {
+		_seen[i].store (0);
+	}
+	_done.store (0);
+
+	pthread_t owner;
+	pthread_t thieves[N_THIEVES];
+
+	CPPUNIT_ASSERT (pthread_create (&owner, NULL, launch_owner, this) == 0);
+	for (int i = 0; i < N_THIEVES; ++i) {
+		CPPUNIT_ASSERT (pthread_create (&thieves[i], NULL, launch_thief, this) == 0);
+	}
+
+	void* return_value;
+	CPPUNIT_ASSERT (pthread_join (owner, &return_value) == 0);
+	for (int i = 0; i < N_THIEVES; ++i) {
+		CPPUNIT_ASSERT (pthread_join (thieves[i], &return_value) == 0);
+	}
+
+	/* every item must have been taken exactly once */
+	for (int i = 0; i < N_ITEMS; ++i) {
+		CPPUNIT_ASSERT_EQUAL (1, _seen[i].load ());
+	}
+}
+
+void
+WorkStealingDequeTest::owner_thread ()
+{
+	intptr_t v;
+	for (intptr_t i = 0; i < N_ITEMS; ++i) {
+		while (!_deque.push_back (i)) {
+			if (_deque.pop_back (v)) {
+				_seen[v].fetch_add (1);
+			}
+		}
+		if ((i % 3) == 0 && _deque.pop_back (v)) {
+			_seen[v].fetch_add (1);
+		}
+	}
+	while (_deque.pop_back (v)) {
+		_seen[v].fetch_add (1);
+	}
+	_done.store (1);
+}
+
+void
+WorkStealingDequeTest::thief_thread ()
+{
+	intptr_t v;
+	while (true) {
+		if (_deque.steal (v)) {
+			_seen[v].fetch_add (1);
+		} else if (_done.load ()) {
+			/* owner drained the deque */
+			break;
+		}
+	}
+}
@@ -0,0 +1,26 @@
+#include <atomic>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "pbd/work_stealing_deque.h"
+
+class WorkStealingDequeTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (WorkStealingDequeTest);
+	CPPUNIT_TEST (single_thread);
+	CPPUNIT_TEST (race);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void single_thread ();
+	void race ();
+
+	void owner_thread ();
+	void thief_thread ();
+
+private:
+	PBD::WorkStealingDeque<intptr_t> _deque;
+	std::vector<std::atomic<int> >   _seen;
+	std::atomic<int>                 _done;
+};
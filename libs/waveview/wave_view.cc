@@ -86,6 +86,7 @@ WaveView::WaveView (Canvas* c, std::shared_ptr<ARDOUR::AudioRegion> region)
 	, _shape_independent (false)
 	, _logscaled_independent (false)
 	, _gradient_depth_independent (false)
+	, _rendered (false)
 	, _draw_image_in_gui_thread (false)
 	, _always_draw_image_in_gui_thread (false)
 {
@@ -99,6 +100,7 @@ WaveView::WaveView (Item* parent, std::shared_ptr<ARDOUR::AudioRegion> region)
 	, _shape_independent (false)
 	, _logscaled_independent (false)
 	, _gradient_depth_independent (false)
+	, _rendered (false)
 	, _draw_image_in_gui_thread (false)
 	, _always_draw_image_in_gui_thread (false)
 {
@@ -123,6 +125,8 @@ WaveView::init ()
 
 WaveView::~WaveView ()
 {
+	cancel_tile_requests ();
+
 #ifdef ENABLE_THREADED_WAVEFORM_RENDERING
 	WaveViewThreads::deinitialize ();
 #endif
@@ -222,6 +226,17 @@ alt_log_meter (float power)
 	return _log_meter (power, -192.0, 0.0, 8.0);
 }
 
+/* round an x coordinate to an exact pixel in device space */
+static double
+window_x (Cairo::RefPtr<Cairo::Context> const& context, double x)
+{
+	double y = 0;
+	context->user_to_device (x, y);
+	x = floor (x);
+	context->device_to_user (x, y);
+	return x;
+}
+
 void
 WaveView::set_clip_level (double dB)
 {
@@ -259,29 +274,74 @@ WaveView::prepare_for_render (Rect const& area) const
 		return;
 	}
 
-	double const image_start_pixel_offset = draw_rect.x0 - self_rect.x0;
-	double const image_end_pixel_offset = draw_rect.x1 - self_rect.x0;
+	if (_props->height < 1 || draw_rect.x0 == draw_rect.x1) {
+		return;
+	}
+
+	/* Also prepare tiles next to the visible area, so that they are
+	 * likely available when the canvas is scrolled. Those are rendered
+	 * after all visible tiles.
+	 */
+	double const margin = std::max<double> (WaveViewProperties::tile_width (), _canvas->visible_area ().width () / 2.0);
 
-	WaveViewProperties required_props = *_props;
+	double const prefetch_start = std::max (self_rect.x0, draw_rect.x0 - margin);
+	double const prefetch_end   = std::min (self_rect.x1, draw_rect.x1 + margin);
 
-	required_props.set_sample_positions_from_pixel_offsets (image_start_pixel_offset,
-	                                                        image_end_pixel_offset);
+	int64_t const first          = _props->tile_at_pixel (draw_rect.x0 - self_rect.x0);
+	int64_t const last           = _props->tile_at_pixel (draw_rect.x1 - self_rect.x0 - 1);
+	int64_t const prefetch_first = _props->tile_at_pixel (prefetch_start - self_rect.x0);
+	int64_t const prefetch_last  = _props->tile_at_pixel (prefetch_end - self_rect.x0 - 1);
 
-	if (!required_props.is_valid ()) {
-		return;
-	}
+	std::shared_ptr<WaveViewCacheGroup> group = get_cache_group ();
 
-	if (_image) {
-		if (_image->props.is_equivalent (required_props)) {
-			return;
+	/* cancel requests for tiles that have gone off-screen, or that were
+	 * made with different properties, worker threads will drop them.
+	 */
+	for (TileRequests::iterator i = _tile_requests.begin (); i != _tile_requests.end ();) {
+		std::shared_ptr<WaveViewDrawRequest> const& req (i->second);
+		if (i->first < prefetch_first || i->first > prefetch_last || req->stopped () ||
+		    !req->image->props.is_equivalent (tile_properties (i->first))) {
+			req->cancel ();
+			_tile_requests.erase (i++);
+		} else if (req->finished ()) {
+			group->add_image (req->image);
+			_tile_requests.erase (i++);
 		} else {
-			// Image does not contain sample area required
+			++i;
 		}
 	}
 
-	std::shared_ptr<WaveViewDrawRequest> request = create_draw_request (required_props);
+	for (int64_t t = prefetch_first; t <= prefetch_last; ++t) {
+		bool const visible = t >= first && t <= last;
+
+		TileRequests::iterator i = _tile_requests.find (t);
+
+		if (i != _tile_requests.end ()) {
+			if (visible && !i->second->visible ()) {
+				/* queue it again, ahead of off-screen tiles */
+				i->second->set_visible (true);
+				WaveViewThreads::enqueue_draw_request (i->second);
+			}
+			continue;
+		}
+
+		WaveViewProperties const props (tile_properties (t));
+
+		if (!props.is_tile_valid ()) {
+			continue;
+		}
+
+		TileMap::const_iterator img = _tiles.find (t);
+		if (img != _tiles.end () && img->second->props.is_equivalent (props)) {
+			continue;
+		}
+
+		if (group->lookup_image (props)) {
+			continue;
+		}
 
-	queue_draw_request (request);
+		queue_draw_request (t, create_draw_request (props), visible);
+	}
 }
 
 bool
@@ -331,7 +391,7 @@ WaveView::get_item_and_draw_rect_in_window_coords (Rect const& canvas_rect, Rect
 }
 
 void
-WaveView::queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const& request) const
+WaveView::queue_draw_request (int64_t tile, std::shared_ptr<WaveViewDrawRequest> const& request, bool visible) const
 {
 	// Don't enqueue any requests without a thread to dequeue them.
 	assert (WaveViewThreads::enabled());
@@ -340,30 +400,27 @@ WaveView::queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const& reques
 		return;
 	}
 
-	if (current_request) {
-		current_request->cancel ();
-	}
+	TileRequests::iterator i = _tile_requests.find (tile);
 
-	std::shared_ptr<WaveViewImage> cached_image =
-	    get_cache_group ()->lookup_image (request->image->props);
+	if (i != _tile_requests.end ()) {
+		i->second->cancel ();
+	}
 
-	if (cached_image) {
-		// The image may not be finished at this point but that is fine, great in
-		// fact as it means it should only need to be drawn once.
-		request->image = cached_image;
-		current_request = request;
-	} else {
-		// now we can finally set an optimal image now that we are not using the
-		// properties for comparisons.
-		request->image->props.set_width_samples (optimal_image_width_samples ());
+	WaveViewCache::get_instance ()->count_miss ();
 
-		current_request = request;
+	request->set_visible (visible);
+	_tile_requests[tile] = request;
 
-		// Add it to the cache so that other WaveViews can refer to the same image
-		get_cache_group()->add_image (current_request->image);
+	WaveViewThreads::enqueue_draw_request (_tile_requests[tile]);
+}
 
-		WaveViewThreads::enqueue_draw_request (current_request);
+void
+WaveView::cancel_tile_requests () const
+{
+	for (TileRequests::iterator i = _tile_requests.begin (); i != _tile_requests.end (); ++i) {
+		i->second->cancel ();
 	}
+	_tile_requests.clear ();
 }
 
 void
@@ -800,77 +857,89 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 }
 
 samplecnt_t
-WaveView::optimal_image_width_samples () const
+WaveView::source_length () const
 {
-	/* Compute how wide the image should be in samples.
-	 *
-	 * The resulting image should be wider than the canvas width so that the
-	 * image does not have to be redrawn each time the canvas offset changes, but
-	 * drawing too much unnecessarily, for instance when zooming into the canvas
-	 * the part of the image that is outside of the visible canvas area may never
-	 * be displayed and will just increase apparent render time and reduce
-	 * responsiveness in non-threaded rendering and cause "flashing" waveforms in
-	 * threaded rendering mode.
-	 *
-	 * Another thing to consider is that if there are a number of waveforms on
-	 * the canvas that are the width of the canvas then we don't want to have to
-	 * draw the images for them all at once as it will cause a spike in render
-	 * time, or in threaded rendering mode it will mean all the draw requests will
-	 * the queued during the same sample/expose event. This issue can be
-	 * alleviated by using an element of randomness in selecting the image width.
-	 *
-	 * If the value of samples per pixel is less than 1/10th of a second, use
-	 * 1/10th of a second instead.
-	 */
+	return _region->audio_source (_props->channel)->length ().samples ();
+}
 
-	samplecnt_t canvas_width_samples = _canvas->visible_area().width() * _props->samples_per_pixel;
-	const samplecnt_t one_tenth_of_second = _region->session().sample_rate() / 10;
+WaveViewProperties
+WaveView::tile_properties (int64_t tile) const
+{
+	WaveViewProperties props (*_props);
+	props.set_tile (tile, source_length ());
+	return props;
+}
 
-	/* If zoomed in where a canvas item interects with the canvas area but
-	 * stretches for many pages either side, to avoid having draw all images when
-	 * the canvas scrolls by a page width the multiplier would have to be a
-	 * randomized amount centered around 3 times the visible canvas width, but
-	 * for other operations like zooming or even with a stationary playhead it is
-	 * a lot of extra drawing that can affect performance.
-	 *
-	 * So without making things too complicated with different widths for
-	 * different operations, try to use a width that is a balance and will work
-	 * well for scrolling(non-page width) so all the images aren't redrawn at the
-	 * same time but also faster for sequential zooming operations.
-	 *
-	 * Canvas items that don't intersect with the edges of the visible canvas
-	 * will of course only draw images that are the pixel width of the item.
-	 *
-	 * It is a perhaps a coincidence that these values are centered roughly
-	 * around the golden ratio but they did work well in my testing.
-	 */
-	const double min_multiplier = 1.4;
-	const double max_multiplier = 1.8;
+std::shared_ptr<WaveViewImage>
+WaveView::get_tile (int64_t tile, WaveViewProperties const& props) const
+{
+	WaveViewCache* cache = WaveViewCache::get_instance ();
 
-	/**
-	 * A combination of high resolution screens, high samplerates and high
-	 * zoom levels(1 sample per pixel) can cause 1/10 of a second(in
-	 * pixels) to exceed the cairo image size limit.
-	 */
-	const double cairo_image_limit = 32767.0;
-	const double max_image_width = cairo_image_limit / max_multiplier;
+	TileMap::const_iterator i = _tiles.find (tile);
 
-	samplecnt_t max_width_samples = floor (max_image_width / _props->samples_per_pixel);
+	if (i != _tiles.end () && i->second->props.is_equivalent (props)) {
+		cache->count_hit ();
+		return i->second;
+	}
 
-	const samplecnt_t one_tenth_of_second_limited = std::min (one_tenth_of_second, max_width_samples);
+	std::shared_ptr<WaveViewCacheGroup> group = get_cache_group ();
 
-	samplecnt_t new_sample_count = std::max (canvas_width_samples, one_tenth_of_second_limited);
+	TileRequests::iterator r = _tile_requests.find (tile);
 
-	const double multiplier = g_random_double_range (min_multiplier, max_multiplier);
+	if (r != _tile_requests.end ()) {
+		if (!r->second->image->props.is_equivalent (props)) {
+			// The WaveView properties may have been updated during recording between
+			// prepare_for_render and render calls and the new required props have
+			// different end sample value.
+			r->second->cancel ();
+			_tile_requests.erase (r);
+			r = _tile_requests.end ();
+		} else if (r->second->finished ()) {
+			std::shared_ptr<WaveViewImage> image = r->second->image;
+			_tile_requests.erase (r);
+			group->add_image (image);
+			return image;
+		}
+	}
 
-	return new_sample_count * multiplier;
-}
+	std::shared_ptr<WaveViewImage> image = group->lookup_image (props);
 
-void
-WaveView::set_image (std::shared_ptr<WaveViewImage> img) const
-{
-	get_cache_group ()->add_image (img);
-	_image = img;
+	if (image) {
+		cache->count_hit ();
+		return image;
+	}
+
+	if (draw_image_in_gui_thread ()) {
+		if (r != _tile_requests.end ()) {
+			r->second->cancel ();
+			_tile_requests.erase (r);
+		} else {
+			cache->count_miss ();
+		}
+	} else if (r == _tile_requests.end ()) {
+		// Defer the rendering to another thread or perhaps render pass if
+		// a thread cannot generate it in time.
+		queue_draw_request (tile, create_draw_request (props), true);
+		return image;
+	} else if (_canvas->get_microseconds_since_render_start () < 15000) {
+		// Drawing image in GUI thread as we have time
+		r->second->cancel ();
+		_tile_requests.erase (r);
+	} else {
+		// Waiting for the request to finish
+		return image;
+	}
+
+	std::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (props);
+
+	process_draw_request (request);
+
+	if (request->finished ()) {
+		image = request->image;
+		group->add_image (image);
+	}
+
+	return image;
 }
 
 void
@@ -886,6 +955,8 @@ WaveView::process_draw_request (std::shared_ptr<WaveViewDrawRequest> req)
 		return;
 	}
 
+	int64_t const start = g_get_monotonic_time ();
+
 	(void) Temporal::TempoMap::fetch();
 
 	WaveViewProperties const& props = req->image->props;
@@ -948,6 +1019,8 @@ WaveView::process_draw_request (std::shared_ptr<WaveViewDrawRequest> req)
 	// Assign now that we are sure all drawing is complete as that is what
 	// determines whether a request was finished.
 	req->image->cairo_image = cairo_image;
+
+	WaveViewCache::get_instance ()->count_rendered (g_get_monotonic_time () - start);
 }
 
 bool
@@ -996,148 +1069,89 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 		return;
 	}
 
-	WaveViewProperties required_props = *_props;
-
-	required_props.set_sample_positions_from_pixel_offsets (image_start_pixel_offset,
-	                                                        image_end_pixel_offset);
-
-	assert (required_props.is_valid());
+	/* round the image origin position to an exact pixel in device space
+	 * to avoid blurring
+	 */
 
-	std::shared_ptr<WaveViewImage> image_to_draw;
+	double x = self.x0;
+	double y = self.y0;
+	context->user_to_device (x, y);
+	y = floor (y);
+	context->device_to_user (x, y);
 
-	if (current_request) {
-		if (!current_request->image->props.is_equivalent (required_props)) {
-			// The WaveView properties may have been updated during recording between
-			// prepare_for_render and render calls and the new required props have
-			// different end sample value.
-			current_request->cancel ();
-			current_request.reset ();
-		} else if (current_request->finished ()) {
-			image_to_draw = current_request->image;
-			current_request.reset ();
-		}
-	} else {
-		// No current Request
-	}
+	std::shared_ptr<WaveViewCacheGroup> group = get_cache_group ();
 
-	if (!image_to_draw && _image) {
-		if (_image->props.is_equivalent (required_props)) {
-			// Image contains required properties
-			image_to_draw = _image;
-		} else {
-			// Image does not contain properties required
-		}
-	}
+	int64_t const first = _props->tile_at_pixel (image_start_pixel_offset);
+	int64_t const last  = _props->tile_at_pixel (image_end_pixel_offset - 1);
 
-	if (!image_to_draw) {
-		image_to_draw = get_cache_group ()->lookup_image (required_props);
-		if (image_to_draw && !image_to_draw->finished ()) {
-			// Found equivalent but unfinished Image in cache
-			image_to_draw.reset ();
-		}
-	}
+	TileMap tiles;
+	bool complete = true;
 
-	if (!image_to_draw) {
-		// No existing image to draw
+	for (int64_t t = first; t <= last; ++t) {
 
-		std::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (required_props);
+		WaveViewProperties const props (tile_properties (t));
 
-		if (draw_image_in_gui_thread ()) {
-			// now that we have to draw something, draw more than required.
-			request->image->props.set_width_samples (optimal_image_width_samples ());
+		if (!props.is_tile_valid ()) {
+			continue;
+		}
 
-			process_draw_request (request);
+		/* the part of the draw area covered by this tile. Tiles are
+		 * clipped so that they do not overlap, the waveform may be
+		 * translucent.
+		 */
+		double const x0 = std::max (draw.x0, window_x (context, self.x0 + (props.tile_start_sample (t) - _props->region_start) / _props->samples_per_pixel));
+		double const x1 = std::min (draw.x1, window_x (context, self.x0 + (props.tile_start_sample (t + 1) - _props->region_start) / _props->samples_per_pixel));
 
-			image_to_draw = request->image;
+		if (x1 <= x0) {
+			continue;
+		}
 
-		} else if (current_request) {
-			if (current_request->finished ()) {
-				// There is a chance the request is now finished since checking above
-				image_to_draw = current_request->image;
-				current_request.reset ();
-			} else if (_canvas->get_microseconds_since_render_start () < 15000) {
-				current_request->cancel ();
-				current_request.reset ();
+		std::shared_ptr<WaveViewImage> image = get_tile (t, props);
 
-				// Drawing image in GUI thread as we have time
+		if (image) {
+			tiles[t] = image;
 
-				// now that we have to draw something, draw more than required.
-				request->image->props.set_width_samples (optimal_image_width_samples ());
+			/* the coordinates specify where in "user coordinates" (i.e. what we
+			 * generally call "canvas coordinates" in this code) the image origin
+			 * will appear. So specifying (10,10) will put the upper left corner of
+			 * the image at (10,10) in user space.
+			 */
+			context->rectangle (x0, draw.y0, x1 - x0, draw.height ());
+			context->set_source (image->cairo_image, window_x (context, self.x0 + (image->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel), y);
+			context->fill ();
+			continue;
+		}
 
-				process_draw_request (request);
+		complete = false;
 
-				image_to_draw = request->image;
-			} else {
-				// Waiting for current request to finish
-				redraw ();
-				return;
-			}
-		} else {
-			// Defer the rendering to another thread or perhaps render pass if
-			// a thread cannot generate it in time.
-			queue_draw_request (request);
-			redraw ();
-			return;
+		/* Until the tile is rendered, scale an image of the closest zoom
+		 * level to fit, if there is one.
+		 */
+		image = group->lookup_nearest_image (props);
+
+		if (image) {
+			context->save ();
+			context->rectangle (x0, draw.y0, x1 - x0, draw.height ());
+			context->clip ();
+			context->translate (self.x0 + (image->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel, y);
+			context->scale (image->props.samples_per_pixel / _props->samples_per_pixel, 1.0);
+			context->set_source (image->cairo_image, 0, 0);
+			context->paint ();
+			context->restore ();
 		}
 	}
 
+	_tiles.swap (tiles);
+
 	/* reset this so that future missing images can be generated in a worker thread. */
 	_draw_image_in_gui_thread = false;
 
-	assert (image_to_draw);
-
-	/* compute the first pixel of the image that should be used when we
-	 * render the specified range.
-	 */
-
-	double image_origin_in_self_coordinates =
-	    (image_to_draw->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel;
-
-	/* the image may only be a best-effort ... it may not span the entire
-	 * range requested, though it is guaranteed to cover the start. So
-	 * determine how many pixels we can actually draw.
-	 */
-
-	const double draw_start_pixel = draw.x0;
-	const double draw_end_pixel = draw.x1;
-
-	double draw_width_pixels = draw_end_pixel - draw_start_pixel;
-
-	if (image_to_draw != _image) {
-
-		/* the image is guaranteed to start at or before
-		 * draw_start. But if it starts before draw_start, that reduces
-		 * the maximum available width we can render with.
-		 *
-		 * so .. clamp the draw width to the smaller of what we need to
-		 * draw or the available width of the image.
-		 */
-		draw_width_pixels = min ((double)image_to_draw->cairo_image->get_width (), draw_width_pixels);
-
-		set_image (image_to_draw);
+	if (complete) {
+		_rendered = true;
+	} else {
+		// Waiting for tiles to be rendered in another thread
+		redraw ();
 	}
-
-	context->rectangle (draw_start_pixel, draw.y0, draw_width_pixels, draw.height());
-
-	/* round image origin position to an exact pixel in device space to
-	 * avoid blurring
-	 */
-
-	double x  = self.x0 + image_origin_in_self_coordinates;
-	double y  = self.y0;
-	context->user_to_device (x, y);
-	x = floor (x);
-	y = floor (y);
-	context->device_to_user (x, y);
-
-	/* the coordinates specify where in "user coordinates" (i.e. what we
-	 * generally call "canvas coordinates" in this code) the image origin
-	 * will appear. So specifying (10,10) will put the upper left corner of
-	 * the image at (10,10) in user space.
-	 */
-
-	context->set_source (image_to_draw->cairo_image, x, y);
-	context->fill ();
 }
 
 void
@@ -1380,6 +1394,20 @@ WaveView::set_image_cache_size (uint64_t sz)
 	WaveViewCache::get_instance()->set_image_cache_threshold (sz);
 }
 
+WaveView::CacheStats
+WaveView::cache_stats ()
+{
+	CacheStats stats;
+	WaveViewCache::get_instance ()->get_stats (stats);
+	return stats;
+}
+
+void
+WaveView::reset_cache_stats ()
+{
+	WaveViewCache::get_instance ()->reset_stats ();
+}
+
 std::shared_ptr<WaveViewCacheGroup>
 WaveView::get_cache_group () const
 {
@@ -86,78 +86,111 @@ WaveViewCacheGroup::~WaveViewCacheGroup ()
 void
 WaveViewCacheGroup::add_image (std::shared_ptr<WaveViewImage> image)
 {
-	if (!image) {
-		// Not adding invalid image to cache
+	if (!image || !image->finished ()) {
+		// Not adding invalid or unfinished image to cache
 		return;
 	}
 
-	ImageCache::iterator oldest_image_it = _cached_images.begin();
-	ImageCache::iterator second_oldest_image_it = _cached_images.end();
+	ImageKey const key (image->props.samples_per_pixel, image->props.get_sample_start ());
 
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		if ((*it) == image) {
+	std::pair<ImageCache::iterator, ImageCache::iterator> range = _cached_images.equal_range (key);
+
+	for (ImageCache::iterator it = range.first; it != range.second; ++it) {
+		if ((*it).second == image) {
 			// Must never be more than one instance of the image in the cache
-			(*it)->timestamp = g_get_monotonic_time ();
+			(*it).second->timestamp = g_get_monotonic_time ();
 			return;
-		} else if ((*it)->props.is_equivalent (image->props)) {
+		} else if ((*it).second->props.is_equivalent (image->props)) {
 			// Equivalent Image already in cache, updating timestamp
-			(*it)->timestamp = g_get_monotonic_time ();
+			(*it).second->timestamp = g_get_monotonic_time ();
 			return;
 		}
-
-		if ((*it)->timestamp < (*oldest_image_it)->timestamp) {
-			second_oldest_image_it = oldest_image_it;
-			oldest_image_it = it;
-		}
 	}
 
 	// no duplicate or equivalent image so we are definitely adding it to cache
 	image->timestamp = g_get_monotonic_time ();
 
 	if (_parent_cache.full () || full ()) {
-		if (oldest_image_it != _cached_images.end()) {
-			// Replacing oldest Image in cache
-			_parent_cache.decrease_size ((*oldest_image_it)->size_in_bytes ());
-			*oldest_image_it = image;
-			_parent_cache.increase_size (image->size_in_bytes ());
-
-			if (second_oldest_image_it != _cached_images.end ()) {
-				// Removing second oldest Image in cache
-				_parent_cache.decrease_size ((*second_oldest_image_it)->size_in_bytes ());
-				_cached_images.erase (second_oldest_image_it);
-			}
-			return;
-		} else {
-			/**
-			 * Add the image to the cache even if the threshold is exceeded so that
-			 * new WaveViews can still cache images with a full cache, the size of
-			 * the cache will quickly equalize back to the threshold as new images
-			 * are added and the size of the cache is reduced.
-			 */
-		}
+		/* Remove the two oldest images, if any. The image is added to
+		 * the cache even if the threshold is exceeded so that new
+		 * WaveViews can still cache images with a full cache, the size of
+		 * the cache will quickly equalize back to the threshold as new
+		 * images are added and the size of the cache is reduced.
+		 */
+		remove_oldest_image ();
+		remove_oldest_image ();
 	}
 
-	_cached_images.push_back (image);
+	_cached_images.insert (std::make_pair (key, image));
 	_parent_cache.increase_size (image->size_in_bytes ());
 }
 
+void
+WaveViewCacheGroup::remove_oldest_image ()
+{
+	ImageCache::iterator oldest_image_it = _cached_images.begin();
+
+	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
+		if ((*it).second->timestamp < (*oldest_image_it).second->timestamp) {
+			oldest_image_it = it;
+		}
+	}
+
+	if (oldest_image_it != _cached_images.end ()) {
+		_parent_cache.decrease_size ((*oldest_image_it).second->size_in_bytes ());
+		_cached_images.erase (oldest_image_it);
+	}
+}
+
 std::shared_ptr<WaveViewImage>
 WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
 {
-	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
-		if ((*i)->props.is_equivalent (props)) {
-			return (*i);
+	ImageKey const key (props.samples_per_pixel, props.get_sample_start ());
+
+	std::pair<ImageCache::iterator, ImageCache::iterator> range = _cached_images.equal_range (key);
+
+	for (ImageCache::iterator i = range.first; i != range.second; ++i) {
+		if ((*i).second->props.is_equivalent (props)) {
+			(*i).second->timestamp = g_get_monotonic_time ();
+			return (*i).second;
 		}
 	}
 	return std::shared_ptr<WaveViewImage>();
 }
 
+std::shared_ptr<WaveViewImage>
+WaveViewCacheGroup::lookup_nearest_image (WaveViewProperties const& props)
+{
+	std::shared_ptr<WaveViewImage> rv;
+	double best = 0;
+
+	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
+		WaveViewProperties const& p ((*i).second->props);
+
+		if (p.samples_per_pixel == props.samples_per_pixel || !p.is_similar (props)) {
+			continue;
+		}
+		if (p.get_sample_end () <= props.get_sample_start () || p.get_sample_start () >= props.get_sample_end ()) {
+			continue;
+		}
+
+		/* distance of zoom levels, on a log scale */
+		double const d = fabs (log (p.samples_per_pixel / props.samples_per_pixel));
+
+		if (!rv || d < best) {
+			rv   = (*i).second;
+			best = d;
+		}
+	}
+	return rv;
+}
+
 void
 WaveViewCacheGroup::clear_cache ()
 {
 	// Tell the parent cache about the images we are about to drop references to
 	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		_parent_cache.decrease_size ((*it)->size_in_bytes ());
+		_parent_cache.decrease_size ((*it).second->size_in_bytes ());
 	}
 	_cached_images.clear ();
 }
@@ -168,7 +201,7 @@ WaveViewCache::WaveViewCache ()
 	: image_cache_size (0)
 	, _image_cache_threshold (100 * 1048576) /* bytes */
 {
-
+	reset_stats ();
 }
 
 WaveViewCache::~WaveViewCache ()
@@ -253,6 +286,27 @@ WaveViewCache::set_image_cache_threshold (uint64_t sz)
 	_image_cache_threshold = sz;
 }
 
+void
+WaveViewCache::get_stats (WaveView::CacheStats& stats) const
+{
+	stats.hits        = _hits.load ();
+	stats.misses      = _misses.load ();
+	stats.dropped     = _dropped.load ();
+	stats.rendered    = _rendered.load ();
+	stats.render_time = _render_time.load ();
+	stats.size        = image_cache_size;
+}
+
+void
+WaveViewCache::reset_stats ()
+{
+	_hits.store (0);
+	_misses.store (0);
+	_dropped.store (0);
+	_rendered.store (0);
+	_render_time.store (0);
+}
+
 /*-------------------------------------------------*/
 
 WaveViewThreads::WaveViewThreads ()
@@ -300,7 +354,11 @@ void
 WaveViewThreads::_enqueue_draw_request (std::shared_ptr<WaveViewDrawRequest>& request)
 {
 	Glib::Threads::Mutex::Lock lm (_queue_mutex);
-	_queue.push_back (request);
+	if (request->visible ()) {
+		_queue.push_back (request);
+	} else {
+		_prefetch_queue.push_back (request);
+	}
 	/* wake one (random) thread */
 	_cond.signal ();
 }
@@ -319,22 +377,38 @@ WaveViewThreads::_dequeue_draw_request ()
 
 	assert (!_queue_mutex.trylock());
 
-	if (_queue.empty()) {
+	if (_queue.empty() && _prefetch_queue.empty ()) {
 		_cond.wait (_queue_mutex);
 	}
 
-	std::shared_ptr<WaveViewDrawRequest> req;
-
 	/* queue could be empty at this point because an already running thread
 	 * pulled the request before we were fully awake and reacquired the mutex.
+	 *
+	 * Requests for visible tiles are handled first. Requests that were
+	 * cancelled since they were queued (usually because they are no longer
+	 * on-screen) are dropped, as are requests that were queued twice and
+	 * are already handled by another thread.
 	 */
 
-	if (!_queue.empty()) {
-		req = _queue.front ();
-		_queue.pop_front ();
+	while (!_queue.empty() || !_prefetch_queue.empty ()) {
+		DrawRequestQueueType& q (_queue.empty () ? _prefetch_queue : _queue);
+
+		std::shared_ptr<WaveViewDrawRequest> req = q.front ();
+		q.pop_front ();
+
+		if (req->stopped ()) {
+			if (req->claim ()) {
+				WaveViewCache::get_instance ()->count_dropped ();
+			}
+			continue;
+		}
+
+		if (req->claim ()) {
+			return req;
+		}
 	}
 
-	return req;
+	return std::shared_ptr<WaveViewDrawRequest> ();
 }
 
 void
@@ -380,6 +454,8 @@ WaveViewThreads::stop_threads ()
 WaveViewDrawRequest::WaveViewDrawRequest ()
 {
 	_stop.store (0);
+	_visible.store (0);
+	_claimed.store (0);
 }
 
 WaveViewDrawRequest::~WaveViewDrawRequest ()
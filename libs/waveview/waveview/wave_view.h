@@ -21,6 +21,7 @@
 #ifndef _WAVEVIEW_WAVE_VIEW_H_
 #define _WAVEVIEW_WAVE_VIEW_H_
 
+#include <map>
 #include <memory>
 
 #include <boost/scoped_ptr.hpp>
@@ -66,11 +67,13 @@ public:
 	   when drawing, we will map the zeroth-pixel of the waveview
 	   into a window.
 
-	   The waveview itself contains a set of pre-rendered Cairo::ImageSurfaces
-	   that cache sections of the display. This is filled on-demand and
-	   never cleared until something explicitly marks the cache invalid
-	   (such as a change in samples_per_pixel, the log scaling, rectified or
-	   other view parameters).
+	   The waveform is rendered into fixed-width tiles (Cairo::ImageSurfaces)
+	   that are aligned to the start of the source, and cached per source,
+	   zoom level and tile index. Tiles are shared by all regions of a
+	   source, and re-used when scrolling. Tiles are filled on-demand,
+	   visible tiles first, and tiles of a nearby zoom level are scaled and
+	   drawn as placeholders until the tiles of the current zoom level are
+	   rendered.
 	*/
 
 	WaveView (ArdourCanvas::Canvas*, std::shared_ptr<ARDOUR::AudioRegion>);
@@ -146,6 +149,18 @@ public:
 
 	static void set_image_cache_size (uint64_t);
 
+	struct CacheStats {
+		uint64_t hits;        ///< tiles found in the cache
+		uint64_t misses;      ///< tiles that had to be rendered
+		uint64_t dropped;     ///< draw requests dropped before they were processed
+		uint64_t rendered;    ///< tiles that were rendered
+		uint64_t render_time; ///< total time spent rendering tiles [usec]
+		uint64_t size;        ///< size of the image cache [bytes]
+	};
+
+	static CacheStats cache_stats ();
+	static void reset_cache_stats ();
+
 private:
 	friend class WaveViewThreadClient;
 	friend class WaveViewThreads;
@@ -154,7 +169,9 @@ private:
 
 	boost::scoped_ptr<WaveViewProperties> _props;
 
-	mutable std::shared_ptr<WaveViewImage> _image;
+	/* tiles that were drawn by the last call to render () */
+	typedef std::map<int64_t, std::shared_ptr<WaveViewImage> > TileMap;
+	mutable TileMap _tiles;
 
 	mutable std::shared_ptr<WaveViewCacheGroup> _cache_group;
 
@@ -175,9 +192,10 @@ private:
 	ARDOUR::samplepos_t region_end () const;
 
 	/**
-	 * _image stays non-null after the first time it is set
+	 * _rendered stays true after the first time an image was drawn
 	 */
-	bool rendered () const { return _image.get(); }
+	bool rendered () const { return _rendered; }
+	mutable bool _rendered;
 
 	bool draw_image_in_gui_thread () const;
 
@@ -194,7 +212,9 @@ private:
 
 	void init();
 
-	mutable std::shared_ptr<WaveViewDrawRequest> current_request;
+	/* pending draw requests by tile index */
+	typedef std::map<int64_t, std::shared_ptr<WaveViewDrawRequest> > TileRequests;
+	mutable TileRequests _tile_requests;
 
 	PBD::ScopedConnectionList invalidation_connection;
 
@@ -227,9 +247,16 @@ private:
 	                        std::shared_ptr<WaveViewDrawRequest>);
 	static void draw_absent_image (Cairo::RefPtr<Cairo::ImageSurface>&, ARDOUR::PeakData*, int);
 
-	ARDOUR::samplecnt_t optimal_image_width_samples () const;
+	ARDOUR::samplecnt_t source_length () const;
+
+	WaveViewProperties tile_properties (int64_t tile) const;
+
+	/** @return the finished image of the given tile, or null if it
+	 * is not available (yet).
+	 */
+	std::shared_ptr<WaveViewImage> get_tile (int64_t tile, WaveViewProperties const&) const;
 
-	void set_image (std::shared_ptr<WaveViewImage> img) const;
+	void cancel_tile_requests () const;
 
 	// @return true if item area intersects with draw area
 	bool get_item_and_draw_rect_in_window_coords (ArdourCanvas::Rect const& canvas_rect,
@@ -238,7 +265,7 @@ private:
 
 	std::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&) const;
 
-	void queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const&) const;
+	void queue_draw_request (int64_t tile, std::shared_ptr<WaveViewDrawRequest> const&, bool visible) const;
 
 	static void process_draw_request (std::shared_ptr<WaveViewDrawRequest>);
 
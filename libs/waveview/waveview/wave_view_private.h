@@ -19,7 +19,9 @@
 #ifndef _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 #define _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 
+#include <atomic>
 #include <deque>
+#include <map>
 
 #include "pbd/pthread_utils.h"
 #include "waveview/wave_view.h"
@@ -70,6 +72,39 @@ public: // methods
 		return (sample_end != 0 && samples_per_pixel != 0);
 	}
 
+	/** Width of an image tile in pixels */
+	static uint32_t tile_width () { return 256; }
+
+	/** Tiles are aligned to the start of the source, tile N starts at
+	 * pixel N * tile_width() of the source at the current zoom level.
+	 */
+	samplepos_t tile_start_sample (int64_t tile) const
+	{
+		return llrint (tile * (double) tile_width () * samples_per_pixel);
+	}
+
+	/** @return index of the tile at the given pixel offset from region_start */
+	int64_t tile_at_pixel (double pixel_offset) const
+	{
+		return (int64_t) floor ((region_start / samples_per_pixel + pixel_offset) / tile_width ());
+	}
+
+	/** Set the sample range to that of the given tile, clamped to the
+	 * length of the source, so that tiles can be shared by all regions
+	 * using the same source.
+	 */
+	void set_tile (int64_t tile, ARDOUR::samplecnt_t source_length)
+	{
+		region_start = 0;
+		region_end   = source_length;
+		set_sample_offsets (std::max<samplepos_t> (0, tile_start_sample (tile)), std::max<samplepos_t> (0, tile_start_sample (tile + 1)));
+	}
+
+	bool is_tile_valid () const
+	{
+		return is_valid () && sample_end > sample_start;
+	}
+
 	void set_width_samples (ARDOUR::samplecnt_t const width_samples)
 	{
 		assert (is_valid());
@@ -158,6 +193,18 @@ public: // methods
 		// region_start && start_shift??
 	}
 
+	/** Compare everything but the zoom level and the sample range */
+	bool is_similar (WaveViewProperties const& other) const
+	{
+		return (channel == other.channel &&
+		        height == other.height && amplitude == other.amplitude &&
+		        amplitude_above_axis == other.amplitude_above_axis && fill_color == other.fill_color &&
+		        outline_color == other.outline_color && zero_color == other.zero_color &&
+		        clip_color == other.clip_color && show_zero == other.show_zero &&
+		        logscaled == other.logscaled && shape == other.shape &&
+		        gradient_depth == other.gradient_depth);
+	}
+
 	bool contains (samplepos_t start, samplepos_t end)
 	{
 		return (sample_start <= start && end <= sample_end);
@@ -207,6 +254,15 @@ public:
 	void cancel() { _stop.store (1); }
 	bool finished() { return image->finished(); }
 
+	/* requests for on-screen tiles are processed first */
+	bool visible () const { return (bool) _visible.load (); }
+	void set_visible (bool yn) { _visible.store (yn ? 1 : 0); }
+
+	/** A request may be queued more than once, when it becomes visible.
+	 * @return true if the caller is the first to process the request
+	 */
+	bool claim () { int c = 0; return _claimed.compare_exchange_strong (c, 1); }
+
 	std::shared_ptr<WaveViewImage> image;
 
 	bool is_valid () {
@@ -215,6 +271,8 @@ public:
 
 private:
 	std::atomic<int> _stop; /* intended for atomic access */
+	std::atomic<int> _visible;
+	std::atomic<int> _claimed;
 };
 
 class WaveViewCache;
@@ -231,11 +289,18 @@ public:
 	// @return image with matching properties or null
 	std::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&);
 
+	/** Find an image covering (part of) the sample range of the given
+	 * properties at the closest different zoom level. This is used to
+	 * draw a scaled placeholder until the image is rendered.
+	 * @return image with similar properties or null
+	 */
+	std::shared_ptr<WaveViewImage> lookup_nearest_image (WaveViewProperties const&);
+
 	void add_image (std::shared_ptr<WaveViewImage>);
 
 	bool full () const { return _cached_images.size() > max_size(); }
 
-	static uint32_t max_size () { return 16; }
+	static uint32_t max_size () { return 256; }
 
 	void clear_cache ();
 
@@ -248,8 +313,12 @@ private:
 	 */
 	WaveViewCache& _parent_cache;
 
-	typedef std::list<std::shared_ptr<WaveViewImage> > ImageCache;
+	/* images are tiles, indexed by zoom level and first sample */
+	typedef std::pair<double, samplepos_t> ImageKey;
+	typedef std::multimap<ImageKey, std::shared_ptr<WaveViewImage> > ImageCache;
 	ImageCache _cached_images;
+
+	void remove_oldest_image ();
 };
 
 class WaveViewCache
@@ -266,6 +335,14 @@ public:
 
 	void reset_cache_group (std::shared_ptr<WaveViewCacheGroup>&);
 
+	void count_hit () { _hits.fetch_add (1); }
+	void count_miss () { _misses.fetch_add (1); }
+	void count_dropped () { _dropped.fetch_add (1); }
+	void count_rendered (uint64_t usec) { _rendered.fetch_add (1); _render_time.fetch_add (usec); }
+
+	void get_stats (WaveView::CacheStats&) const;
+	void reset_stats ();
+
 private:
 	WaveViewCache();
 	~WaveViewCache();
@@ -279,6 +356,12 @@ private:
 	uint64_t image_cache_size;
 	uint64_t _image_cache_threshold;
 
+	std::atomic<uint64_t> _hits;
+	std::atomic<uint64_t> _misses;
+	std::atomic<uint64_t> _dropped;
+	std::atomic<uint64_t> _rendered;
+	std::atomic<uint64_t> _render_time;
+
 private:
 	friend class WaveViewCacheGroup;
 
@@ -344,7 +427,8 @@ private:
 	Glib::Threads::Cond _cond;
 
 	typedef std::deque<std::shared_ptr<WaveViewDrawRequest> > DrawRequestQueueType;
-	DrawRequestQueueType _queue;
+	DrawRequestQueueType _queue;          // visible tiles
+	DrawRequestQueueType _prefetch_queue; // tiles next to the visible area
 };
 
 